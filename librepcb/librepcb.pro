@@ -13,7 +13,7 @@ GENERATED_DIR = ../generated
 # Use common project definitions
 include(../common.pri)
 
-QT += core widgets opengl network xml printsupport sql
+QT += core widgets opengl network xml printsupport sql concurrent
 
 exists(../.git):DEFINES += GIT_BRANCH=\\\"master\\\"
 
@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "airwiresbuilder.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+AirWiresBuilder::AirWiresBuilder() noexcept
+{
+}
+
+AirWiresBuilder::~AirWiresBuilder() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int AirWiresBuilder::addPoint(const Point& pos) noexcept
+{
+    mPoints.append(pos);
+    mParents.append(mParents.count());
+    return mPoints.count() - 1;
+}
+
+void AirWiresBuilder::addEdge(int p1, int p2) noexcept
+{
+    Q_ASSERT((p1 >= 0) && (p1 < mParents.count()));
+    Q_ASSERT((p2 >= 0) && (p2 < mParents.count()));
+    int island1 = findIsland(mParents, p1);
+    int island2 = findIsland(mParents, p2);
+    if (island1 != island2) {
+        mParents[island1] = island2;
+    }
+}
+
+QList<AirWiresBuilder::AirWire> AirWiresBuilder::buildAirWires() const noexcept
+{
+    QList<AirWire> airwires;
+    int count = mPoints.count();
+    QVector<int> parents = mParents;
+    int islands = 0;
+    for (int i = 0; i < count; ++i) {
+        if (findIsland(parents, i) == i) ++islands;
+    }
+    if (islands < 2) {
+        return airwires;
+    }
+
+    // build the grid, its cells contain about one point in average
+    QVector<QPointF> positions(count);
+    for (int i = 0; i < count; ++i) {
+        positions[i] = QPointF(mPoints.at(i).getX().toNm(), mPoints.at(i).getY().toNm());
+    }
+    qreal left = positions.first().x(), right = left;
+    qreal top = positions.first().y(), bottom = top;
+    foreach (const QPointF& p, positions) {
+        left = qMin(left, p.x());
+        right = qMax(right, p.x());
+        top = qMin(top, p.y());
+        bottom = qMax(bottom, p.y());
+    }
+    qreal width = right - left;
+    qreal height = bottom - top;
+    qreal cellSize = qMax(qSqrt(width * height / count), qMax(width, height) / count);
+    if (cellSize <= 0) cellSize = 1; // all points are at the same position
+    int columns = qFloor(width / cellSize) + 1;
+    int rows = qFloor(height / cellSize) + 1;
+    QVector<QVector<int>> cells(columns * rows);
+    QVector<int> cellColumns(count);
+    QVector<int> cellRows(count);
+    for (int i = 0; i < count; ++i) {
+        cellColumns[i] = qBound(0, qFloor((positions.at(i).x() - left) / cellSize), columns - 1);
+        cellRows[i] = qBound(0, qFloor((positions.at(i).y() - top) / cellSize), rows - 1);
+        cells[cellRows.at(i) * columns + cellColumns.at(i)].append(i);
+    }
+
+    // Boruvka's algorithm: connect every island to its nearest foreign island per round
+    const qreal infinity = std::numeric_limits<qreal>::max();
+    QVector<int> islandOfPoint(count);
+    QVector<qreal> bestDistances(count);
+    QVector<int> bestFrom(count);
+    QVector<int> bestTo(count);
+    while (islands > 1) {
+        for (int i = 0; i < count; ++i) {
+            islandOfPoint[i] = findIsland(parents, i);
+        }
+        bestDistances.fill(infinity);
+        bestFrom.fill(-1);
+        bestTo.fill(-1);
+
+        for (int i = 0; i < count; ++i) {
+            int island = islandOfPoint.at(i);
+            const QPointF& pos = positions.at(i);
+            qreal best = bestDistances.at(island); // squared distance
+            int bestPoint = -1;
+            auto visitCell = [&](int column, int row) {
+                if ((column < 0) || (column >= columns) || (row < 0) || (row >= rows)) return;
+                foreach (int k, cells.at(row * columns + column)) {
+                    if (islandOfPoint.at(k) == island) continue;
+                    QPointF diff = positions.at(k) - pos;
+                    qreal d = QPointF::dotProduct(diff, diff);
+                    if (d < best) {
+                        best = d;
+                        bestPoint = k;
+                    }
+                }
+            };
+            // search the rings of cells around the point until no closer point is possible
+            int column = cellColumns.at(i);
+            int row = cellRows.at(i);
+            int maxRing = qMax(columns, rows);
+            for (int r = 0; r <= maxRing; ++r) {
+                qreal minRingDistance = (r - 1) * cellSize;
+                if ((minRingDistance > 0) && (minRingDistance * minRingDistance >= best)) break;
+                if (r == 0) {
+                    visitCell(column, row);
+                    continue;
+                }
+                for (int x = column - r; x <= column + r; ++x) {
+                    visitCell(x, row - r);
+                    visitCell(x, row + r);
+                }
+                for (int y = row - r + 1; y <= row + r - 1; ++y) {
+                    visitCell(column - r, y);
+                    visitCell(column + r, y);
+                }
+            }
+            if (bestPoint >= 0) {
+                bestDistances[island] = best;
+                bestFrom[island] = i;
+                bestTo[island] = bestPoint;
+            }
+        }
+
+        // merge the islands (equal distances may lead to duplicate candidates)
+        for (int island = 0; island < count; ++island) {
+            if (bestFrom.at(island) < 0) continue;
+            int island1 = findIsland(parents, bestFrom.at(island));
+            int island2 = findIsland(parents, bestTo.at(island));
+            if (island1 != island2) {
+                parents[island1] = island2;
+                airwires.append(AirWire(mPoints.at(bestFrom.at(island)),
+                                        mPoints.at(bestTo.at(island))));
+                --islands;
+            }
+        }
+    }
+    return airwires;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+int AirWiresBuilder::findIsland(QVector<int>& parents, int point) noexcept
+{
+    while (parents.at(point) != point) {
+        parents[point] = parents.at(parents.at(point)); // path halving
+        point = parents.at(point);
+    }
+    return point;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
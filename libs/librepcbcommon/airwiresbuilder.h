@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_AIRWIRESBUILDER_H
+#define LIBREPCB_AIRWIRESBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "units/point.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class AirWiresBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The AirWiresBuilder class calculates the air wires (ratsnest) of a net
+ *
+ * All anchors of a net (pads, vias, trace points) are added with #addPoint(), and all
+ * existing copper connections between them with #addEdge(). #buildAirWires() then
+ * returns the shortest set of lines which connects all islands of already connected
+ * points (an euclidean minimum spanning tree over the islands).
+ *
+ * The tree is built with Boruvka's algorithm: in each round, every island is connected
+ * to its nearest foreign island, so only a logarithmic number of rounds is needed. The
+ * nearest neighbours are looked up in a uniform grid, which makes each round nearly
+ * linear instead of quadratic in the number of points.
+ */
+class AirWiresBuilder final
+{
+    public:
+
+        // Types
+        typedef QPair<Point, Point> AirWire;
+
+        // Constructors / Destructor
+        AirWiresBuilder() noexcept;
+        AirWiresBuilder(const AirWiresBuilder& other) = delete;
+        ~AirWiresBuilder() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Add a point to connect
+         *
+         * @param pos   The position of the point
+         *
+         * @return The index of the new point (to be used for #addEdge())
+         */
+        int addPoint(const Point& pos) noexcept;
+
+        /**
+         * @brief Mark two points as already connected (e.g. by a trace)
+         *
+         * @param p1    Index of the first point (returned by #addPoint())
+         * @param p2    Index of the second point (returned by #addPoint())
+         */
+        void addEdge(int p1, int p2) noexcept;
+
+        /**
+         * @brief Calculate the air wires which connect all islands
+         *
+         * @return The list of air wires (empty if all points are already connected)
+         */
+        QList<AirWire> buildAirWires() const noexcept;
+
+        // Operator Overloadings
+        AirWiresBuilder& operator=(const AirWiresBuilder& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        static int findIsland(QVector<int>& parents, int point) noexcept;
+
+
+        // Attributes
+        QVector<Point> mPoints;
+        QVector<int> mParents;  ///< union-find forest of the already connected points
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_AIRWIRESBUILDER_H
@@ -91,6 +91,13 @@ BoardDesignRules::BoardDesignRules(const XmlDomElement& domElement) noexcept :
     if (XmlDomElement* e = domElement.getFirstChild("restring_via_max", false)) {
         mRestringViaMax = e->getText<Length>(true);
     }
+    // copper
+    if (XmlDomElement* e = domElement.getFirstChild("copper_clearance", false)) {
+        mCopperClearance = e->getText<Length>(true);
+    }
+    if (XmlDomElement* e = domElement.getFirstChild("copper_min_width", false)) {
+        mCopperMinWidth = e->getText<Length>(true);
+    }
 }
 
 BoardDesignRules::~BoardDesignRules() noexcept
@@ -122,6 +129,9 @@ void BoardDesignRules::restoreDefaults() noexcept
     mRestringViaRatio = qreal(0.25);                // 25%
     mRestringViaMin = Length(200000);               // 0.2mm
     mRestringViaMax = Length(2000000);              // 2.0mm
+    // copper
+    mCopperClearance = Length(200000);              // 0.2mm
+    mCopperMinWidth = Length(150000);               // 0.15mm
 }
 
 XmlDomElement* BoardDesignRules::serializeToXmlDomElement() const throw (Exception)
@@ -148,6 +158,9 @@ XmlDomElement* BoardDesignRules::serializeToXmlDomElement() const throw (Excepti
     root->appendTextChild("restring_via_ratio",                 mRestringViaRatio);
     root->appendTextChild("restring_via_min",                   mRestringViaMin);
     root->appendTextChild("restring_via_max",                   mRestringViaMax);
+    // copper
+    root->appendTextChild("copper_clearance",                   mCopperClearance);
+    root->appendTextChild("copper_min_width",                   mCopperMinWidth);
     // end
     return root.take();
 }
@@ -214,6 +227,9 @@ BoardDesignRules& BoardDesignRules::operator=(const BoardDesignRules& rhs) noexc
     mRestringViaRatio               = rhs.mRestringViaRatio;
     mRestringViaMin                 = rhs.mRestringViaMin;
     mRestringViaMax                 = rhs.mRestringViaMax;
+    // copper
+    mCopperClearance                = rhs.mCopperClearance;
+    mCopperMinWidth                 = rhs.mCopperMinWidth;
     return *this;
 }
 
@@ -241,6 +257,9 @@ bool BoardDesignRules::checkAttributesValidity() const noexcept
     if (mRestringViaRatio < 0)                              return false;
     if (mRestringViaMin < 0)                                return false;
     if (mRestringViaMax < mRestringViaMin)                  return false;
+    // copper
+    if (mCopperClearance < 0)                               return false;
+    if (mCopperMinWidth < 0)                                return false;
     return true;
 }
 
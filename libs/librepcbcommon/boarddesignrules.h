@@ -78,6 +78,10 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         const Length& getRestringViaMin() const noexcept {return mRestringViaMin;}
         const Length& getRestringViaMax() const noexcept {return mRestringViaMax;}
 
+        // Getters: Copper
+        const Length& getCopperClearance() const noexcept {return mCopperClearance;}
+        const Length& getCopperMinWidth() const noexcept {return mCopperMinWidth;}
+
 
         // Setters: General Attributes
         void setName(const QString& name) noexcept {if (!name.isEmpty()) mName = name;}
@@ -102,6 +106,10 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         void setRestringViaMin(const Length& min) noexcept {if (min >= 0) mRestringViaMin = min;}
         void setRestringViaMax(const Length& max) noexcept {if (max >= 0) mRestringViaMax = max;}
 
+        // Setters: Copper
+        void setCopperClearance(const Length& clearance) noexcept {if (clearance >= 0) mCopperClearance = clearance;}
+        void setCopperMinWidth(const Length& width) noexcept {if (width >= 0) mCopperMinWidth = width;}
+
         // General Methods
         void restoreDefaults() noexcept;
 
@@ -147,6 +155,10 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         qreal mRestringViaRatio;
         Length mRestringViaMin;
         Length mRestringViaMax;
+
+        // Copper
+        Length mCopperClearance;    ///< min. distance between copper of different nets
+        Length mCopperMinWidth;     ///< min. width of traces
 };
 
 /*****************************************************************************************
@@ -20,9 +20,9 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <algorithm>
 #include <QtCore>
 #include "excellongenerator.h"
-#include "../fileio/smarttextfile.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -34,7 +34,7 @@ namespace librepcb {
  ****************************************************************************************/
 
 ExcellonGenerator::ExcellonGenerator() noexcept :
-    mOutput()
+    mOutput(), mOptimizeDrillOrder(true)
 {
 }
 
@@ -48,7 +48,7 @@ ExcellonGenerator::~ExcellonGenerator() noexcept
 
 void ExcellonGenerator::drill(const Point& pos, const Length& dia) noexcept
 {
-    mDrillList.insert(dia, pos);
+    mDrillList[dia].append(pos);
 }
 
 void ExcellonGenerator::generate() throw (Exception)
@@ -61,9 +61,22 @@ void ExcellonGenerator::generate() throw (Exception)
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const throw (Exception)
 {
-    QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-    file->setContent(mOutput.toLatin1());
-    file->save(true);
+    if (!filepath.getParentDir().isExistingDir()) {
+        filepath.getParentDir().mkPath();
+    }
+
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString("%1: %2 [%3]")
+            .arg(filepath.toStr(), file.errorString()).arg(file.error()),
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    file.write(mOutput.toLatin1()); // write errors are reported by commit()
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
 }
 
 void ExcellonGenerator::reset() noexcept
@@ -97,21 +110,29 @@ void ExcellonGenerator::printHeader() noexcept
 
 void ExcellonGenerator::printToolList() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        Length dia = mDrillList.uniqueKeys().value(i);
-        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(dia.toMmString()));
+    QList<Length> diameters = mDrillList.keys();
+    for (int i = 0; i < diameters.count(); ++i) {
+        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(diameters.at(i).toMmString()));
     }
 }
 
 void ExcellonGenerator::printDrills() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
+    Point currentPos; // the tool starts at the origin
+    QList<Length> diameters = mDrillList.keys();
+    for (int i = 0; i < diameters.count(); ++i) {
         mOutput.append(QString("T%1\n").arg(i+1)); // Select Tool
-        Length dia = mDrillList.uniqueKeys().value(i);
-        foreach (const Point& pos, mDrillList.values(dia)) {
+        QList<Point> hits = mDrillList.value(diameters.at(i));
+        if (mOptimizeDrillOrder) {
+            optimizeDrillOrder(hits, currentPos);
+        }
+        foreach (const Point& pos, hits) {
             mOutput.append(QString("X%1Y%2\n").arg(pos.getX().toMmString(),
                                                    pos.getY().toMmString()));
         }
+        if (!hits.isEmpty()) {
+            currentPos = hits.last();
+        }
     }
 }
 
@@ -121,6 +142,154 @@ void ExcellonGenerator::printFooter() noexcept
     mOutput.append("M30\n");        // End of Program Rewind
 }
 
+/*****************************************************************************************
+ *  Drill Order Optimization
+ ****************************************************************************************/
+
+void ExcellonGenerator::optimizeDrillOrder(QList<Point>& hits, const Point& startPos) noexcept
+{
+    QList<Point> original = hits;
+    sortByNearestNeighbour(hits, startPos);
+    improveByTwoOpt(hits, startPos);
+
+    // the nearest neighbour search does not guarantee a shorter path than the original
+    // order (e.g. if the hits were already added in a good order), so keep the shorter one
+    if (pathLength(hits, startPos) >= pathLength(original, startPos)) {
+        hits = original;
+    }
+}
+
+void ExcellonGenerator::sortByNearestNeighbour(QList<Point>& hits, const Point& startPos) noexcept
+{
+    if (hits.count() < 2) return;
+
+    // put all hits into a uniform grid with about two hits per cell, so the nearest
+    // neighbour search only needs to look at the cells around the current position
+    qint64 minX = hits.first().getX().toNm(), maxX = minX;
+    qint64 minY = hits.first().getY().toNm(), maxY = minY;
+    foreach (const Point& pos, hits) {
+        minX = qMin(minX, pos.getX().toNm()); maxX = qMax(maxX, pos.getX().toNm());
+        minY = qMin(minY, pos.getY().toNm()); maxY = qMax(maxY, pos.getY().toNm());
+    }
+    qreal area = qMax(qreal(maxX - minX), qreal(1)) * qMax(qreal(maxY - minY), qreal(1));
+    qreal cellSize = qMax(qSqrt(2 * area / hits.count()), qreal(1));
+    int columns = qBound(1, int((maxX - minX) / cellSize) + 1, 4096);
+    int rows = qBound(1, int((maxY - minY) / cellSize) + 1, 4096);
+    qreal cellWidth = qMax(qreal(maxX - minX) / columns, qreal(1));
+    qreal cellHeight = qMax(qreal(maxY - minY) / rows, qreal(1));
+    auto column = [&](const Point& p) {
+        return qBound(0, int((p.getX().toNm() - minX) / cellWidth), columns - 1);};
+    auto row = [&](const Point& p) {
+        return qBound(0, int((p.getY().toNm() - minY) / cellHeight), rows - 1);};
+    QVector<QVector<int>> grid(columns * rows);
+    for (int i = 0; i < hits.count(); ++i) {
+        grid[row(hits.at(i)) * columns + column(hits.at(i))].append(i);
+    }
+
+    QList<Point> sorted;
+    sorted.reserve(hits.count());
+    Point current = startPos;
+    while (sorted.count() < hits.count()) {
+        // search rings of cells around the current position until the nearest hit is
+        // guaranteed to be found (the ring is farther away than the best hit so far)
+        int cx = column(current), cy = row(current);
+        int bestIndex = -1, bestCell = -1, bestSlot = -1;
+        qreal bestDistance = 0;
+        for (int ring = 0; ; ++ring) {
+            if ((bestIndex >= 0) && (qMin(cellWidth, cellHeight) * (ring - 1) > bestDistance)) {
+                break;
+            }
+            if ((cx - ring < 0) && (cy - ring < 0) && (cx + ring >= columns) && (cy + ring >= rows)) {
+                break; // the whole grid has been searched
+            }
+            for (int y = cy - ring; y <= cy + ring; ++y) {
+                if ((y < 0) || (y >= rows)) continue;
+                bool edgeRow = (y == cy - ring) || (y == cy + ring);
+                for (int x = cx - ring; x <= cx + ring; x += (edgeRow ? 1 : 2 * ring)) {
+                    if ((x >= 0) && (x < columns)) {
+                        const QVector<int>& cell = grid.at(y * columns + x);
+                        for (int slot = 0; slot < cell.count(); ++slot) {
+                            qreal d = distance(current, hits.at(cell.at(slot)));
+                            if ((bestIndex < 0) || (d < bestDistance)) {
+                                bestIndex = cell.at(slot);
+                                bestCell = y * columns + x;
+                                bestSlot = slot;
+                                bestDistance = d;
+                            }
+                        }
+                    }
+                    if (ring == 0) break;
+                }
+            }
+        }
+        Q_ASSERT(bestIndex >= 0);
+        current = hits.at(bestIndex);
+        sorted.append(current);
+        QVector<int>& cell = grid[bestCell];
+        cell[bestSlot] = cell.last();
+        cell.removeLast();
+    }
+    hits = sorted;
+}
+
+void ExcellonGenerator::improveByTwoOpt(QList<Point>& hits, const Point& startPos) noexcept
+{
+    // The path starts at startPos (fixed) and has an open end. Only segments which are
+    // close to each other in the path are compared, which keeps the runtime linear in
+    // the number of hits and still removes most crossings left by the nearest neighbour
+    // search.
+    static const int windowSize = 50;
+    static const int maxPasses = 10;
+
+    QVector<Point> path;
+    path.reserve(hits.count() + 1);
+    path.append(startPos);
+    foreach (const Point& pos, hits) path.append(pos);
+
+    int n = path.count();
+    for (int pass = 0; pass < maxPasses; ++pass) {
+        bool improved = false;
+        for (int i = 0; i < n - 2; ++i) {
+            for (int j = i + 2; (j < n) && (j <= i + windowSize); ++j) {
+                // replace the edges (i,i+1) and (j,j+1) by (i,j) and (i+1,j+1)
+                qreal delta = distance(path.at(i), path.at(j))
+                            - distance(path.at(i), path.at(i + 1));
+                if (j + 1 < n) {
+                    delta += distance(path.at(i + 1), path.at(j + 1))
+                           - distance(path.at(j), path.at(j + 1));
+                }
+                if (delta < -1.0) { // ignore improvements below one nanometer
+                    std::reverse(path.begin() + i + 1, path.begin() + j + 1);
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) break;
+    }
+
+    for (int i = 1; i < n; ++i) {
+        hits[i - 1] = path.at(i);
+    }
+}
+
+qreal ExcellonGenerator::pathLength(const QList<Point>& hits, const Point& startPos) noexcept
+{
+    qreal length = 0;
+    Point current = startPos;
+    foreach (const Point& pos, hits) {
+        length += distance(current, pos);
+        current = pos;
+    }
+    return length;
+}
+
+qreal ExcellonGenerator::distance(const Point& p1, const Point& p2) noexcept
+{
+    qreal dx = p2.getX().toNm() - p1.getX().toNm();
+    qreal dy = p2.getY().toNm() - p1.getY().toNm();
+    return qSqrt(dx * dx + dy * dy);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
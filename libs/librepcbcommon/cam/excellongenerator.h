@@ -57,6 +57,20 @@ class ExcellonGenerator final
 
         // Getters
         const QString& toStr() const noexcept {return mOutput;}
+        bool isDrillOrderOptimizationEnabled() const noexcept {return mOptimizeDrillOrder;}
+
+        // Setters
+
+        /**
+         * @brief Enable or disable the optimization of the drill order
+         *
+         * If enabled (the default), #generate() reorders the hits of each tool with a
+         * nearest neighbour search followed by a 2-opt improvement to reduce the travel
+         * distance of the drilling machine (the original order is kept if it is already
+         * shorter). Otherwise the hits are written in the order
+         * they were added.
+         */
+        void setDrillOrderOptimizationEnabled(bool enabled) noexcept {mOptimizeDrillOrder = enabled;}
 
         // General Methods
         void drill(const Point& pos, const Length& dia) noexcept;
@@ -75,10 +89,18 @@ class ExcellonGenerator final
         void printDrills() noexcept;
         void printFooter() noexcept;
 
+        // Drill Order Optimization
+        static void optimizeDrillOrder(QList<Point>& hits, const Point& startPos) noexcept;
+        static void sortByNearestNeighbour(QList<Point>& hits, const Point& startPos) noexcept;
+        static void improveByTwoOpt(QList<Point>& hits, const Point& startPos) noexcept;
+        static qreal pathLength(const QList<Point>& hits, const Point& startPos) noexcept;
+        static qreal distance(const Point& p1, const Point& p2) noexcept;
+
 
         // Excellon Data
         QString mOutput;
-        QMultiMap<Length, Point> mDrillList;
+        QMap<Length, QList<Point>> mDrillList; ///< key: tool diameter; value: hits in drill order
+        bool mOptimizeDrillOrder;
 };
 
 /*****************************************************************************************
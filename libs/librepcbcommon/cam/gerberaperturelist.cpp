@@ -64,40 +64,30 @@ QString GerberApertureList::generateString() const noexcept
 
 int GerberApertureList::setCircle(const Length& dia, const Length& hole)
 {
-    return setCurrentAperture(generateCircle(dia, hole));
+    return setCurrentAperture(Shape_t::Circle, dia, 0, Angle::deg0(), hole);
 }
 
 int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateRect(w, h, hole));
+        return setCurrentAperture(Shape_t::Rect, w, h, Angle::deg0(), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateRect(h, w, hole));
+        return setCurrentAperture(Shape_t::Rect, h, w, Angle::deg0(), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
-        if (hole > 0) {
-            addMacro(generateRotatedRectMacroWithHole());
-        } else {
-            addMacro(generateRotatedRectMacro());
-        }
-        return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+        return setCurrentAperture(Shape_t::RotatedRect, w, h, rot, hole);
     }
 }
 
 int GerberApertureList::setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateObround(w, h, hole));
+        return setCurrentAperture(Shape_t::Obround, w, h, Angle::deg0(), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateObround(h, w, hole));
+        return setCurrentAperture(Shape_t::Obround, h, w, Angle::deg0(), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
-        if (hole > 0) {
-            addMacro(generateRotatedObroundMacroWithHole());
-        } else {
-            addMacro(generateRotatedObroundMacro());
-        }
-        return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+        return setCurrentAperture(Shape_t::RotatedObround, w, h, rot, hole);
     }
 }
 
@@ -108,30 +98,58 @@ int GerberApertureList::setRegularPolygon(const Length& dia, int n, const Angle&
     }
     // Adjust rotation as its interpretation differs between LibrePCB and Gerber specs
     Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-    return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+    return setCurrentAperture(Shape_t::RegularPolygon, dia, 0, grbRot, hole, n);
 }
 
 void GerberApertureList::reset() noexcept
 {
     //mApertureMacros.clear();
     mApertures.clear();
+    mApertureNumbers.clear();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept
+int GerberApertureList::setCurrentAperture(Shape_t shape, const Length& w, const Length& h,
+                                           const Angle& rot, const Length& hole, int n) noexcept
 {
-    int number = mApertures.key(aperture, -1);
+    // a non-positive hole diameter means "no hole", normalize it to get a unique key
+    Aperture aperture{shape, w, h, rot, (hole > 0) ? hole : Length(0), n};
+    int number = mApertureNumbers.value(aperture, -1);
     if (number < 0) {
         number = mApertures.count() + 10; // 10 is the number of the first aperture
         Q_ASSERT(!mApertures.contains(number));
-        mApertures.insert(number, aperture);
+        mApertures.insert(number, generateAperture(aperture));
+        mApertureNumbers.insert(aperture, number);
     }
     return number;
 }
 
+QString GerberApertureList::generateAperture(const Aperture& a) noexcept
+{
+    switch (a.shape) {
+        case Shape_t::Circle:
+            return generateCircle(a.width, a.hole);
+        case Shape_t::Rect:
+            return generateRect(a.width, a.height, a.hole);
+        case Shape_t::Obround:
+            return generateObround(a.width, a.height, a.hole);
+        case Shape_t::RegularPolygon:
+            return generateRegularPolygon(a.width, a.vertices, a.rotation, a.hole);
+        case Shape_t::RotatedRect:
+            addMacro((a.hole > 0) ? generateRotatedRectMacroWithHole() : generateRotatedRectMacro());
+            return generateRotatedRect(a.width, a.height, a.rotation, a.hole);
+        case Shape_t::RotatedObround:
+            addMacro((a.hole > 0) ? generateRotatedObroundMacroWithHole() : generateRotatedObroundMacro());
+            return generateRotatedObround(a.width, a.height, a.rotation, a.hole);
+        default:
+            Q_ASSERT(false);
+            return QString();
+    }
+}
+
 void GerberApertureList::addMacro(const QString& macro) noexcept
 {
     if (!mApertureMacros.contains(macro)) {
@@ -72,8 +72,43 @@ class GerberApertureList final
 
     private:
 
+        // Types
+        enum class Shape_t {Circle, Rect, Obround, RegularPolygon, RotatedRect, RotatedObround};
+
+        /**
+         * @brief Structured aperture descriptor, used as key for the aperture lookup
+         *
+         * Two descriptors compare equal exactly if they lead to the same aperture
+         * definition, so the definition string only needs to be generated once per
+         * aperture.
+         */
+        struct Aperture {
+            Shape_t shape;
+            Length width;       ///< diameter for circles and regular polygons
+            Length height;      ///< unused for circles and regular polygons
+            Angle rotation;     ///< unused for circles and non-rotated rects/obrounds
+            Length hole;        ///< 0 if there is no hole
+            int vertices;       ///< only used for regular polygons
+
+            bool operator==(const Aperture& rhs) const noexcept {
+                return (shape == rhs.shape) && (width == rhs.width) && (height == rhs.height)
+                    && (rotation == rhs.rotation) && (hole == rhs.hole) && (vertices == rhs.vertices);
+            }
+            friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+                seed ^= ::qHash(static_cast<int>(key.shape)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= ::qHash(key.width.toNm()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= ::qHash(key.height.toNm()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= ::qHash(key.rotation.toMicroDeg()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= ::qHash(key.hole.toNm()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= ::qHash(key.vertices) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                return seed;
+            }
+        };
+
         // Private Methods
-        int setCurrentAperture(const QString& aperture) noexcept;
+        int setCurrentAperture(Shape_t shape, const Length& w, const Length& h,
+                               const Angle& rot, const Length& hole, int n = 0) noexcept;
+        QString generateAperture(const Aperture& aperture) noexcept;
         void addMacro(const QString& macro) noexcept;
 
         // Aperture Generator Methods
@@ -91,6 +126,7 @@ class GerberApertureList final
 
         QList<QString> mApertureMacros;
         QMap<int, QString> mApertures; ///< key: aperture number (>= 10); value: aperture definition
+        QHash<Aperture, int> mApertureNumbers; ///< reverse lookup of #mApertures
 };
 
 /*****************************************************************************************
@@ -25,7 +25,6 @@
 #include "gerberaperturelist.h"
 #include "../geometry/ellipse.h"
 #include "../geometry/polygon.h"
-#include "../fileio/smarttextfile.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -44,6 +43,7 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
     mApertureList(new GerberApertureList()), mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false)
 {
+    mContent.reserve(64 * 1024); // avoid many small reallocations at the beginning
 }
 
 GerberGenerator::~GerberGenerator() noexcept
@@ -200,17 +200,29 @@ void GerberGenerator::reset() noexcept
 void GerberGenerator::generate() throw (Exception)
 {
     mOutput.clear();
-    printHeader();
-    printApertureList();
-    printContent();
-    printFooter();
+    QBuffer buffer(&mOutput);
+    buffer.open(QIODevice::WriteOnly);
+    writeOutput(buffer);
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const throw (Exception)
 {
-    QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-    file->setContent(mOutput.toLatin1());
-    file->save(true);
+    if (!filepath.getParentDir().isExistingDir()) {
+        filepath.getParentDir().mkPath();
+    }
+
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString("%1: %2 [%3]")
+            .arg(filepath.toStr(), file.errorString()).arg(file.error()),
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    writeOutput(file);
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
 }
 
 /*****************************************************************************************
@@ -220,7 +232,9 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const throw (Exceptio
 void GerberGenerator::setCurrentAperture(int number) noexcept
 {
     if (number != mCurrentApertureNumber) {
-        mContent.append(QString("D%1*\n").arg(number));
+        mContent.append('D');
+        appendNumber(number);
+        mContent.append("*\n");
         mCurrentApertureNumber = number;
     }
 }
@@ -268,14 +282,14 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D02*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(pos);
+    mContent.append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D01*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(pos);
+    mContent.append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept
@@ -284,73 +298,112 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start, const Po
     if (!mMultiQuadrantArcModeOn) {
         diff.makeAbs(); // no sign allowed in single quadrant mode!
     }
-    mContent.append(QString("X%1Y%2I%3J%4D01*\n").arg(end.getX().toNmString(),
-                                                      end.getY().toNmString(),
-                                                      diff.getX().toNmString(),
-                                                      diff.getY().toNmString()));
+    appendCoordinates(end);
+    mContent.append('I');
+    appendNumber(diff.getX().toNm());
+    mContent.append('J');
+    appendNumber(diff.getY().toNm());
+    mContent.append("D01*\n");
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D03*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(pos);
+    mContent.append("D03*\n");
+}
+
+void GerberGenerator::appendCoordinates(const Point& pos) noexcept
+{
+    // coordinate format "6.6" in millimeters --> nanometers can be written directly
+    mContent.append('X');
+    appendNumber(pos.getX().toNm());
+    mContent.append('Y');
+    appendNumber(pos.getY().toNm());
+}
+
+void GerberGenerator::appendNumber(qint64 number) noexcept
+{
+    // much faster than QString::number() and doesn't need any temporary heap allocation
+    char buffer[24];
+    char* const end = buffer + sizeof(buffer);
+    char* begin = end;
+    quint64 value = (number < 0) ? (0 - static_cast<quint64>(number)) : static_cast<quint64>(number);
+    do {
+        *(--begin) = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+    if (number < 0) {
+        *(--begin) = '-';
+    }
+    mContent.append(begin, end - begin);
+}
+
+void GerberGenerator::writeOutput(QIODevice& device) const throw (Exception)
+{
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    writeData(device, md5, generateHeader());
+    writeData(device, md5, mApertureList->generateString().toLatin1());
+    writeData(device, md5, "G04 --- BOARD BEGIN --- *\n");
+    writeData(device, md5, mContent);
+    writeData(device, md5, "G04 --- BOARD END --- *\n");
+
+    // MD5 checksum over all data written so far
+    writeData(device, md5, "%TF.MD5," + md5.result().toHex() + "*%\n");
+
+    // end of file
+    writeData(device, md5, "M02*\n");
 }
 
-void GerberGenerator::printHeader() noexcept
+QByteArray GerberGenerator::generateHeader() const noexcept
 {
-    mOutput.append("G04 --- HEADER BEGIN --- *\n");
+    QByteArray header;
+    header.append("G04 --- HEADER BEGIN --- *\n");
 
     // add some X2 attributes
-    mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(qApp->applicationVersion()));
-    mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
-    mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(mProjectId, mProjectGuid, mProjectRevision));
-    mOutput.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
-    //mOutput.append("%TF.FilePolarity,Positive*%\n");
+    header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(qApp->applicationVersion()).toLatin1());
+    header.append(QString("%TF.CreationDate,%1*%\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)).toLatin1());
+    header.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(mProjectId, mProjectGuid, mProjectRevision).toLatin1());
+    header.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
+    //header.append("%TF.FilePolarity,Positive*%\n");
 
     // coordinate format specification:
     //  - leading zeros omitted
     //  - absolute coordinates
     //  - coordiante format "6.6" --> allows us to directly use LengthBase_t (nanometers)!
-    mOutput.append("%FSLAX66Y66*%\n");
+    header.append("%FSLAX66Y66*%\n");
 
     // set unit to millimeters
-    mOutput.append("%MOMM*%\n");
+    header.append("%MOMM*%\n");
 
     // start linear interpolation mode
-    mOutput.append("G01*\n");
+    header.append("G01*\n");
 
     // use single quadrant arc mode
-    mOutput.append("G74*\n");
-
-    mOutput.append("G04 --- HEADER END --- *\n");
-}
-
-void GerberGenerator::printApertureList() noexcept
-{
-    mOutput.append(mApertureList->generateString());
-}
+    header.append("G74*\n");
 
-void GerberGenerator::printContent() noexcept
-{
-    mOutput.append("G04 --- BOARD BEGIN --- *\n");
-    mOutput.append(mContent);
-    mOutput.append("G04 --- BOARD END --- *\n");
+    header.append("G04 --- HEADER END --- *\n");
+    return header;
 }
 
-void GerberGenerator::printFooter() noexcept
-{
-    // MD5 checksum over content
-    mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
-
-    // end of file
-    mOutput.append("M02*\n");
-}
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept
+void GerberGenerator::writeData(QIODevice& device, QCryptographicHash& md5,
+                                const QByteArray& data) throw (Exception)
 {
     // according to the RS-274C standard, linebreaks are not included in the checksum
-    QString data = QString(mOutput).remove(QChar('\n'));
-    return QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+    int start = 0;
+    for (int end = data.indexOf('\n'); end >= 0; end = data.indexOf('\n', start)) {
+        md5.addData(data.constData() + start, end - start);
+        start = end + 1;
+    }
+    md5.addData(data.constData() + start, data.size() - start);
+
+    if (device.write(data) != data.size()) {
+        throw RuntimeError(__FILE__, __LINE__, device.errorString(),
+            QString(tr("Could not write Gerber data: %1")).arg(device.errorString()));
+    }
 }
 
 /*****************************************************************************************
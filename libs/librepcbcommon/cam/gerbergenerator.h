@@ -70,7 +70,7 @@ class GerberGenerator final
         ~GerberGenerator() noexcept;
 
         // Getters
-        const QString& toStr() const noexcept {return mOutput;}
+        const QByteArray& toByteArray() const noexcept {return mOutput;}
 
         // Plot Methods
         void setLayerPolarity(LayerPolarity p) noexcept;
@@ -86,7 +86,25 @@ class GerberGenerator final
 
         // General Methods
         void reset() noexcept;
+
+        /**
+         * @brief Generate the whole Gerber file in memory (see #toByteArray())
+         *
+         * @note This is not needed for #saveToFile().
+         */
         void generate() throw (Exception);
+
+        /**
+         * @brief Write the Gerber file directly to the file system
+         *
+         * The output is streamed to the file (and the MD5 checksum is calculated while
+         * writing), so the whole file is never copied in memory. Only the drawn content
+         * is buffered (see #mContent).
+         *
+         * @param filepath  The file to create or overwrite
+         *
+         * @throw Exception If the file could not be written
+         */
         void saveToFile(const FilePath& filepath) const throw (Exception);
 
         // Operator Overloadings
@@ -108,11 +126,14 @@ class GerberGenerator final
         void linearInterpolateToPosition(const Point& pos) noexcept;
         void circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept;
         void flashAtPosition(const Point& pos) noexcept;
-        void printHeader() noexcept;
-        void printApertureList() noexcept;
-        void printContent() noexcept;
-        void printFooter() noexcept;
-        QString calcOutputMd5Checksum() const noexcept;
+        void appendCoordinates(const Point& pos) noexcept;
+        void appendNumber(qint64 number) noexcept;
+        void writeOutput(QIODevice& device) const throw (Exception);
+        QByteArray generateHeader() const noexcept;
+
+        // Static Methods
+        static void writeData(QIODevice& device, QCryptographicHash& md5,
+                              const QByteArray& data) throw (Exception);
 
 
         // Metadata
@@ -121,8 +142,15 @@ class GerberGenerator final
         QString mProjectRevision;
 
         // Gerber Data
-        QString mOutput;
-        QString mContent;
+        QByteArray mOutput;     ///< the whole file (only after calling #generate())
+
+        /**
+         * @brief The ASCII data between aperture list and footer
+         *
+         * This can't be streamed to the file while drawing because the aperture list
+         * has to be written before it, but is only complete after everything is drawn.
+         */
+        QByteArray mContent;
         QScopedPointer<GerberApertureList> mApertureList;
         int mCurrentApertureNumber;
         bool mMultiQuadrantArcModeOn;
@@ -0,0 +1,281 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "clearancechecker.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ClearanceChecker::ClearanceChecker(const Length& clearance) noexcept :
+    mClearance(clearance), mCellSize(0)
+{
+}
+
+ClearanceChecker::~ClearanceChecker() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int ClearanceChecker::addItem(const Shape& shape, int net) noexcept
+{
+    Q_ASSERT(!shape.vertices.isEmpty());
+    mShapes.append(shape);
+    mNets.append(net);
+    return mShapes.count() - 1;
+}
+
+void ClearanceChecker::buildGrid(const Length& cellSize) noexcept
+{
+    qreal clearance = mClearance.toNm();
+    if (cellSize > 0) {
+        mCellSize = cellSize.toNm();
+    } else {
+        // the cell size is chosen to be about the size of an average item
+        qreal sizeSum = 0;
+        foreach (const Shape& shape, mShapes) {
+            sizeSum += qMax(shape.bounds.width(), shape.bounds.height());
+        }
+        qreal averageSize = mShapes.isEmpty() ? 0 : sizeSum / mShapes.count();
+        mCellSize = qMax(averageSize + clearance, qreal(1000)); // at least 1um
+    }
+
+    // add each item to all cells touched by its bounds, extended by half the clearance
+    qreal margin = clearance / 2;
+    mCells.clear();
+    for (int i = 0; i < mShapes.count(); ++i) {
+        QRectF rect = mShapes.at(i).bounds.adjusted(-margin, -margin, margin, margin);
+        int x1 = qFloor(rect.left() / mCellSize);
+        int x2 = qFloor(rect.right() / mCellSize);
+        int y1 = qFloor(rect.top() / mCellSize);
+        int y2 = qFloor(rect.bottom() / mCellSize);
+        for (int x = x1; x <= x2; ++x) {
+            for (int y = y1; y <= y2; ++y) {
+                mCells[CellIndex(x, y)].append(i);
+            }
+        }
+    }
+}
+
+QList<ClearanceChecker::Violation> ClearanceChecker::checkCells(
+    const QVector<CellIndex>& cells) const noexcept
+{
+    QList<Violation> violations;
+    qreal clearance = mClearance.toNm();
+    qreal margin = clearance / 2;
+    foreach (const CellIndex& cell, cells) {
+        const QVector<int> indices = mCells.value(cell);
+        for (int i = 0; i < indices.count(); ++i) {
+            int a = indices.at(i);
+            QRectF rectA = mShapes.at(a).bounds.adjusted(-margin, -margin, margin, margin);
+            for (int k = i + 1; k < indices.count(); ++k) {
+                int b = indices.at(k);
+                if ((mNets.at(a) >= 0) && (mNets.at(a) == mNets.at(b))) continue;
+                QRectF rectB = mShapes.at(b).bounds.adjusted(-margin, -margin, margin, margin);
+                QRectF overlap = rectA.intersected(rectB);
+                if (overlap.isNull()) continue;
+                // a pair which shares several cells is only checked in one of them
+                if ((qFloor(overlap.left() / mCellSize) != cell.first) ||
+                    (qFloor(overlap.top() / mCellSize) != cell.second)) {
+                    continue;
+                }
+                // allow a tolerance of 1nm to avoid false positives caused by rounding
+                qreal d = distance(mShapes.at(a), mShapes.at(b));
+                if (d + 1 < clearance) {
+                    violations.append(Violation{a, b, Length(qRound64(d))});
+                }
+            }
+        }
+    }
+    return violations;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+ClearanceChecker::Shape ClearanceChecker::createShape(const QVector<QPointF>& vertices,
+                                                      qreal radius) noexcept
+{
+    Q_ASSERT(!vertices.isEmpty());
+    qreal left = vertices.first().x(), right = left;
+    qreal top = vertices.first().y(), bottom = top;
+    foreach (const QPointF& p, vertices) {
+        left = qMin(left, p.x());
+        right = qMax(right, p.x());
+        top = qMin(top, p.y());
+        bottom = qMax(bottom, p.y());
+    }
+    QRectF bounds(QPointF(left - radius, top - radius), QPointF(right + radius, bottom + radius));
+    return Shape{vertices, radius, bounds};
+}
+
+ClearanceChecker::Shape ClearanceChecker::createTraceShape(const Point& p1, const Point& p2,
+                                                           const Length& width) noexcept
+{
+    QVector<QPointF> vertices;
+    vertices.append(toNmQPointF(p1));
+    vertices.append(toNmQPointF(p2));
+    return createShape(vertices, width.toNm() / qreal(2));
+}
+
+ClearanceChecker::Shape ClearanceChecker::createRectShape(const Point& center,
+    const Length& width, const Length& height, const Angle& rotation) noexcept
+{
+    Length w = width / 2;
+    Length h = height / 2;
+    QList<Point> vertices;
+    vertices << Point(w, h) << Point(-w, h) << Point(-w, -h) << Point(w, -h);
+    return createShape(center, vertices, rotation, Length(0));
+}
+
+ClearanceChecker::Shape ClearanceChecker::createObroundShape(const Point& center,
+    const Length& width, const Length& height, const Angle& rotation) noexcept
+{
+    // a line between the centers of the two semicircles, or a point for circles
+    Length w = width / 2;
+    Length h = height / 2;
+    QList<Point> vertices;
+    if (w > h) {
+        vertices << Point(h - w, 0) << Point(w - h, 0);
+    } else if (h > w) {
+        vertices << Point(0, w - h) << Point(0, h - w);
+    } else {
+        vertices << Point(0, 0);
+    }
+    return createShape(center, vertices, rotation, qMin(w, h));
+}
+
+ClearanceChecker::Shape ClearanceChecker::createOctagonShape(const Point& center,
+    const Length& width, const Length& height, const Angle& rotation) noexcept
+{
+    Length w = width / 2;
+    Length h = height / 2;
+    Length a = qMin(w, h).scaled(2 - qSqrt(2));
+    QList<Point> vertices;
+    vertices << Point(w, h-a) << Point(w-a, h) << Point(a-w, h) << Point(-w, h-a)
+             << Point(-w, a-h) << Point(a-w, -h) << Point(w-a, -h) << Point(w, a-h);
+    return createShape(center, vertices, rotation, Length(0));
+}
+
+qreal ClearanceChecker::distance(const Shape& a, const Shape& b) noexcept
+{
+    const QVector<QPointF>& va = a.vertices;
+    const QVector<QPointF>& vb = b.vertices;
+    qreal d = 0;
+    if (!contains(va, vb.first()) && !contains(vb, va.first())) {
+        // a single vertex is handled as a zero-length edge, two vertices as one edge
+        int edgesA = (va.count() < 3) ? 1 : va.count();
+        int edgesB = (vb.count() < 3) ? 1 : vb.count();
+        d = std::numeric_limits<qreal>::max();
+        for (int i = 0; (i < edgesA) && (d > 0); ++i) {
+            const QPointF& p1 = va.at(i);
+            const QPointF& p2 = va.at((i + 1) % va.count());
+            for (int k = 0; (k < edgesB) && (d > 0); ++k) {
+                const QPointF& q1 = vb.at(k);
+                const QPointF& q2 = vb.at((k + 1) % vb.count());
+                if (intersects(p1, p2, q1, q2)) {
+                    d = 0;
+                } else {
+                    d = qMin(d, qMin(qMin(distance(p1, q1, q2), distance(p2, q1, q2)),
+                                     qMin(distance(q1, p1, p2), distance(q2, p1, p2))));
+                }
+            }
+        }
+    }
+    return qMax(d - a.radius - b.radius, qreal(0));
+}
+
+qreal ClearanceChecker::distance(const QPointF& p, const QPointF& s1, const QPointF& s2) noexcept
+{
+    QPointF s = s2 - s1;
+    qreal lengthSquared = QPointF::dotProduct(s, s);
+    qreal t = (lengthSquared > 0) ? QPointF::dotProduct(p - s1, s) / lengthSquared : 0;
+    QPointF nearest = s1 + s * qBound(qreal(0), t, qreal(1));
+    QPointF diff = p - nearest;
+    return qSqrt(QPointF::dotProduct(diff, diff));
+}
+
+bool ClearanceChecker::intersects(const QPointF& p1, const QPointF& p2,
+                                  const QPointF& q1, const QPointF& q2) noexcept
+{
+    // only proper crossings, touching segments have a point-to-segment distance of zero
+    qreal d1 = cross(q1, q2, p1);
+    qreal d2 = cross(q1, q2, p2);
+    qreal d3 = cross(p1, p2, q1);
+    qreal d4 = cross(p1, p2, q2);
+    return (((d1 > 0) && (d2 < 0)) || ((d1 < 0) && (d2 > 0))) &&
+           (((d3 > 0) && (d4 < 0)) || ((d3 < 0) && (d4 > 0)));
+}
+
+bool ClearanceChecker::contains(const QVector<QPointF>& polygon, const QPointF& p) noexcept
+{
+    if (polygon.count() < 3) return false;
+    bool positive = false, negative = false;
+    for (int i = 0; i < polygon.count(); ++i) {
+        qreal c = cross(polygon.at(i), polygon.at((i + 1) % polygon.count()), p);
+        if (c > 0) positive = true;
+        if (c < 0) negative = true;
+    }
+    return !(positive && negative);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+ClearanceChecker::Shape ClearanceChecker::createShape(const Point& center,
+    const QList<Point>& vertices, const Angle& rotation, const Length& radius) noexcept
+{
+    QVector<QPointF> sceneVertices;
+    foreach (const Point& vertex, vertices) {
+        sceneVertices.append(toNmQPointF(center + vertex.rotated(rotation)));
+    }
+    return createShape(sceneVertices, radius.toNm());
+}
+
+qreal ClearanceChecker::cross(const QPointF& o, const QPointF& a, const QPointF& b) noexcept
+{
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+QPointF ClearanceChecker::toNmQPointF(const Point& point) noexcept
+{
+    return QPointF(point.getX().toNm(), point.getY().toNm());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLEARANCECHECKER_H
+#define LIBREPCB_CLEARANCECHECKER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ClearanceChecker
+ ****************************************************************************************/
+
+/**
+ * @brief The ClearanceChecker class finds shapes of different nets which are too close
+ *
+ * All shapes of one copper layer are added with #addItem(). #buildGrid() then sorts them
+ * into a uniform grid to find candidate pairs of shapes (broad phase), and #checkCells()
+ * calculates the exact distance only between these candidates (narrow phase). The cells
+ * can be checked concurrently by splitting #getCells() into several chunks, each pair of
+ * shapes is reported at most once even if it shares several cells.
+ *
+ * All shapes are represented as a convex polygon (or a line segment or a point) which is
+ * inflated by a radius, so traces, round vias, obround pads and rectangular pads all use
+ * the same distance calculation.
+ */
+class ClearanceChecker final
+{
+    public:
+
+        // Types
+        typedef QPair<int, int> CellIndex;
+        struct Shape {
+            QVector<QPointF> vertices;  ///< convex, in nanometers
+            qreal radius;               ///< in nanometers
+            QRectF bounds;              ///< including the radius
+        };
+        struct Violation {
+            int item1;          ///< index of the first item (see #addItem())
+            int item2;          ///< index of the second item (see #addItem())
+            Length clearance;   ///< the actual clearance between both items
+        };
+
+        // Constructors / Destructor
+        explicit ClearanceChecker(const Length& clearance = Length(0)) noexcept;
+        ~ClearanceChecker() noexcept;
+
+        // Getters
+        const Length& getClearance() const noexcept {return mClearance;}
+        int getItemCount() const noexcept {return mShapes.count();}
+        QVector<CellIndex> getCells() const noexcept {return mCells.keys().toVector();}
+
+        // General Methods
+
+        /**
+         * @brief Add a shape to check
+         *
+         * @param shape     The shape of the item (see #createShape())
+         * @param net       Shapes of the same net are never checked against each other,
+         *                  except -1 which is used for unconnected items
+         *
+         * @return The index of the new item (used in #Violation)
+         */
+        int addItem(const Shape& shape, int net) noexcept;
+
+        /**
+         * @brief Sort all items into the grid, needs to be called before #checkCells()
+         *
+         * @param cellSize  The size of the grid cells, or zero to choose it automatically
+         *                  (about the size of an average item)
+         */
+        void buildGrid(const Length& cellSize = Length(0)) noexcept;
+
+        /**
+         * @brief Check the clearance between the items of some grid cells
+         *
+         * This method is thread-safe as long as the checker is not modified.
+         *
+         * @param cells     The cells to check (a subset of #getCells())
+         *
+         * @return All pairs of items which are too close together
+         */
+        QList<Violation> checkCells(const QVector<CellIndex>& cells) const noexcept;
+
+        // Static Methods
+        static Shape createShape(const QVector<QPointF>& vertices, qreal radius) noexcept;
+        static Shape createTraceShape(const Point& p1, const Point& p2,
+                                      const Length& width) noexcept;
+        static Shape createRectShape(const Point& center, const Length& width,
+                                     const Length& height, const Angle& rotation) noexcept;
+        static Shape createObroundShape(const Point& center, const Length& width,
+                                        const Length& height, const Angle& rotation) noexcept;
+        static Shape createOctagonShape(const Point& center, const Length& width,
+                                        const Length& height, const Angle& rotation) noexcept;
+        static qreal distance(const Shape& a, const Shape& b) noexcept;
+        static qreal distance(const QPointF& p, const QPointF& s1, const QPointF& s2) noexcept;
+        static bool intersects(const QPointF& p1, const QPointF& p2,
+                               const QPointF& q1, const QPointF& q2) noexcept;
+        static bool contains(const QVector<QPointF>& polygon, const QPointF& p) noexcept;
+
+
+    private:
+
+        // Private Methods
+        static Shape createShape(const Point& center, const QList<Point>& vertices,
+                                 const Angle& rotation, const Length& radius) noexcept;
+        static qreal cross(const QPointF& o, const QPointF& a, const QPointF& b) noexcept;
+        static QPointF toNmQPointF(const Point& point) noexcept;
+
+
+        // Attributes
+        Length mClearance;
+        QVector<Shape> mShapes;
+        QVector<int> mNets;     ///< the net of each item in #mShapes
+        qreal mCellSize;        ///< in nanometers
+        QHash<CellIndex, QVector<int>> mCells;  ///< indices of #mShapes
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CLEARANCECHECKER_H
@@ -154,6 +154,8 @@ void Debug::print(DebugLevel_t level, const QString& msg, const char* file, int
     QString logMsg = QString("[%1] %2 (%3:%4)").arg(levelStr, msg.toLocal8Bit().constData(),
                                                     file).arg(line);
 
+    QMutexLocker locker(&mMutex);
+
     if (mDebugLevelStderr >= level)
     {
         // write to stderr
@@ -79,6 +79,19 @@ void SmartXmlFile::save(const XmlDomDocument& domDocument, bool toOriginal) thro
     updateMembersAfterSaving(toOriginal);
 }
 
+std::function<void()> SmartXmlFile::prepareAutosave(const QSharedPointer<const XmlDomDocument>& domDocument) throw (Exception)
+{
+    Q_ASSERT(domDocument);
+    Q_ASSERT((!domDocument->hasFileVersion()) || (domDocument->getFileVersion() >= 0));
+    Q_ASSERT((!domDocument->hasFileVersion()) || (domDocument->getFileVersion() <= APP_VERSION_MAJOR));
+
+    // the members do not need to be updated as the original file is not touched
+    FilePath filepath = prepareSaveAndReturnFilePath(false);
+    return [filepath, domDocument]() {
+        saveContentToFile(filepath, domDocument->toByteArray());
+    };
+}
+
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
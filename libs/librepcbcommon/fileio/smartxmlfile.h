@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include "smartfile.h"
 
 /*****************************************************************************************
@@ -104,6 +105,22 @@ class SmartXmlFile final : public SmartFile
          */
         void save(const XmlDomDocument& domDocument, bool toOriginal) throw (Exception);
 
+        /**
+         * @brief Prepare writing a XML DOM tree to the temporary file in another thread
+         *
+         * This is used for autosaving: the (cheap) preparation is done in the calling
+         * thread, while the returned function formats the DOM tree and writes the
+         * temporary file (*.*~). The returned function does not access this object, so
+         * it can be executed in any thread, even after this object was destroyed.
+         *
+         * @param domDocument   The DOM document to save (must not be modified anymore)
+         *
+         * @return A function which writes the file (throws an Exception on error)
+         *
+         * @throw Exception If an error occurs
+         */
+        std::function<void()> prepareAutosave(const QSharedPointer<const XmlDomDocument>& domDocument) throw (Exception);
+
 
         // Static Methods
 
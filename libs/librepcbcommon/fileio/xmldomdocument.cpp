@@ -42,15 +42,23 @@ XmlDomDocument::XmlDomDocument(XmlDomElement& root) noexcept :
 XmlDomDocument::XmlDomDocument(const QByteArray& xmlFileContent, const FilePath& filepath) throw (Exception) :
     mFilePath(filepath), mRootElement(nullptr)
 {
-    QDomDocument doc;
-    doc.implementation().setInvalidDataPolicy(QDomImplementation::ReturnNullNode);
-
-    QString errMsg;
-    int errLine;
-    int errColumn;
-    if (!doc.setContent(xmlFileContent, &errMsg, &errLine, &errColumn))
+    // build the DOM tree in a single pass while reading the XML content
+    QXmlStreamReader reader(xmlFileContent);
+    reader.setNamespaceProcessing(false);
+    while ((!reader.atEnd()) && (!reader.isStartElement()))
+        reader.readNext(); // skip the XML declaration, comments etc.
+    if (reader.isStartElement())
+        mRootElement = XmlDomElement::fromXmlStreamReader(reader, this);
+    while (!reader.atEnd())
+        reader.readNext(); // check the rest of the document for errors
+
+    if (reader.hasError())
     {
-        QString line = xmlFileContent.split('\n').at(errLine-1);
+        delete mRootElement;    mRootElement = nullptr;
+        QString errMsg = reader.errorString();
+        int errLine = reader.lineNumber();
+        int errColumn = reader.columnNumber();
+        QString line = xmlFileContent.split('\n').value(errLine-1);
         throw RuntimeError(__FILE__, __LINE__, QString("%1: %2 [%3:%4] LINE:%5")
             .arg(filepath.toStr(), errMsg).arg(errLine).arg(errColumn).arg(line),
             QString(tr("Error while parsing XML in file \"%1\": %2 [%3:%4]"))
@@ -58,14 +66,11 @@ XmlDomDocument::XmlDomDocument(const QByteArray& xmlFileContent, const FilePath&
     }
 
     // check if the root node exists
-    QDomElement root = doc.documentElement();
-    if (root.isNull())
+    if (!mRootElement)
     {
         throw RuntimeError(__FILE__, __LINE__, QString(),
-            QString(tr("No XML root node found in \"%1\"!")).arg(/*xmlFilePath.toNative()*/QString()));
+            QString(tr("No XML root node found in \"%1\"!")).arg(filepath.toNative()));
     }
-
-    mRootElement = XmlDomElement::fromQDomElement(root, this);
 }
 
 XmlDomDocument::~XmlDomDocument() noexcept
@@ -107,11 +112,15 @@ void XmlDomDocument::setFileVersion(int version) noexcept
 
 QByteArray XmlDomDocument::toByteArray() const noexcept
 {
-    QDomDocument doc;
-    doc.implementation().setInvalidDataPolicy(QDomImplementation::ReturnNullNode);
-    doc.setContent(QString("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"));
-    doc.appendChild(mRootElement->toQDomElement(doc));
-    return doc.toByteArray(1); // indent only 1 space to save disk space
+    Q_ASSERT(mRootElement != nullptr);
+    QByteArray content;
+    QXmlStreamWriter writer(&content);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1); // indent only 1 space to save disk space
+    writer.writeStartDocument("1.0", true);
+    mRootElement->writeToXmlStreamWriter(writer);
+    writer.writeEndDocument();
+    return content;
 }
 
 /*****************************************************************************************
@@ -24,7 +24,6 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
-#include <QDomDocument>
 #include "../exceptions.h"
 #include "filepath.h"
 
@@ -133,6 +132,9 @@ class XmlDomDocument final
         /**
          * @brief Export the whole DOM tree as a QByteArray to write back to the XML file
          *
+         * The elements are serialized directly with a QXmlStreamWriter, so no
+         * intermediate DOM tree is created.
+         *
          * @return The XML DOM tree which can be written into an XML file
          */
         QByteArray toByteArray() const noexcept;
@@ -39,33 +39,15 @@ namespace librepcb {
  ****************************************************************************************/
 
 XmlDomElement::XmlDomElement(const QString& name, const QString& text) noexcept :
-    mDocument(nullptr), mParent(nullptr), mName(name), mText(text)
+    mDocument(nullptr), mParent(nullptr), mIndex(-1), mName(name), mText(text)
 {
     Q_ASSERT(isValidXmlTagName(mName) == true);
 }
 
-XmlDomElement::XmlDomElement(QDomElement domElement, XmlDomElement* parent, XmlDomDocument* doc) noexcept :
-    mDocument(doc), mParent(parent), mName(domElement.tagName()), mText()
-{
-    Q_ASSERT(isValidXmlTagName(mName) == true);
-
-    QDomNamedNodeMap map = domElement.attributes();
-    for (int i = 0; i < map.count(); i++)
-        mAttributes.insert(map.item(i).nodeName(), map.item(i).nodeValue());
-
-    QDomElement child = domElement.firstChildElement();
-    while (!child.isNull())
-    {
-        mChilds.append(new XmlDomElement(child, this));
-        child = child.nextSiblingElement();
-    }
-
-    if (mChilds.isEmpty())
-        mText = domElement.text();
-}
-
 XmlDomElement::~XmlDomElement() noexcept
 {
+    foreach (XmlDomElement* child, mChilds)
+        child->mParent = nullptr; // avoid removing the childs one by one from mChilds
     qDeleteAll(mChilds);        mChilds.clear();
 
     if (mParent)
@@ -270,7 +252,11 @@ Length XmlDomElement::getText<Length>(bool throwIfEmpty, const Length& defaultVa
 template <>
 void XmlDomElement::setAttribute(const QString& name, const QString& value) noexcept
 {
-    mAttributes.insert(name, value);
+    int index = indexOfAttribute(name);
+    if (index >= 0)
+        mAttributes[index].value = value;
+    else
+        mAttributes.append(Attribute{name, value});
 }
 
 template <>
@@ -341,7 +327,14 @@ void XmlDomElement::setAttribute(const QString& name, const VAlign& value) noexc
 
 bool XmlDomElement::hasAttribute(const QString& name) const noexcept
 {
-    return mAttributes.contains(name);
+    return (indexOfAttribute(name) >= 0);
+}
+
+void XmlDomElement::removeAttribute(const QString& name) noexcept
+{
+    int index = indexOfAttribute(name);
+    if (index >= 0)
+        mAttributes.remove(index);
 }
 
 template <>
@@ -350,17 +343,19 @@ QString XmlDomElement::getAttribute<QString>(const QString& name, bool throwIfEm
     Q_UNUSED(defaultValue);
     Q_ASSERT(defaultValue == QString()); // defaultValue makes no sense in this method
 
-    if (!mAttributes.contains(name))
+    int index = indexOfAttribute(name);
+    if (index < 0)
     {
         throw FileParseError(__FILE__, __LINE__, getDocFilePath(), -1, -1, QString(),
             QString(tr("Attribute \"%1\" not found in node \"%2\".")).arg(name, mName));
     }
-    if (mAttributes.value(name).isEmpty() && throwIfEmpty)
+    const QString& value = mAttributes.at(index).value;
+    if (value.isEmpty() && throwIfEmpty)
     {
         throw FileParseError(__FILE__, __LINE__, getDocFilePath(), -1, -1, QString(),
             QString(tr("Attribute \"%1\" in node \"%2\" must not be empty.")).arg(name, mName));
     }
-    return mAttributes.value(name);
+    return value;
 }
 
 template <>
@@ -558,23 +553,25 @@ VAlign XmlDomElement::getAttribute<VAlign>(const QString& name, bool throwIfEmpt
 void XmlDomElement::removeChild(XmlDomElement* child, bool deleteChild) noexcept
 {
     Q_ASSERT(child);
-    Q_ASSERT(mChilds.contains(child) == true);
-    mChilds.removeOne(child);
-    if (deleteChild) {
+    Q_ASSERT(child->mParent == this);
+    Q_ASSERT(mChilds.value(child->mIndex) == child);
+    mChilds.removeAt(child->mIndex);
+    for (int i = child->mIndex; i < mChilds.count(); ++i)
+        mChilds.at(i)->mIndex = i;
+    child->mParent = nullptr;
+    child->mIndex = -1;
+    if (deleteChild)
         delete child;
-    } else {
-        child->mParent = nullptr;
-    }
 }
 
 void XmlDomElement::appendChild(XmlDomElement* child) noexcept
 {
     Q_ASSERT(mText.isNull() == true);
     Q_ASSERT(child);
-    Q_ASSERT(mChilds.contains(child) == false);
     Q_ASSERT(child->mDocument == nullptr);
     Q_ASSERT(child->mParent == nullptr);
     child->mParent = this;
+    child->mIndex = mChilds.count();
     mChilds.append(child);
 }
 
@@ -681,11 +678,11 @@ XmlDomElement* XmlDomElement::getFirstChild(const QString& pathName, bool throwI
 XmlDomElement* XmlDomElement::getPreviousChild(const XmlDomElement* child, const QString& name,
                                                bool throwIfNotFound) const throw (Exception)
 {
+    Q_ASSERT(child && (child->mParent == this));
     XmlDomElement* previousChild = const_cast<XmlDomElement*>(child);
     do
     {
-        int index = mChilds.indexOf(const_cast<XmlDomElement*>(previousChild));
-        Q_ASSERT(index > -1);
+        int index = previousChild->mIndex; // stored index -> no need to search the list
         if (index > 0)
             previousChild = mChilds.at(index-1);
         else if (!throwIfNotFound)
@@ -702,11 +699,11 @@ XmlDomElement* XmlDomElement::getPreviousChild(const XmlDomElement* child, const
 XmlDomElement* XmlDomElement::getNextChild(const XmlDomElement* child, const QString& name,
                                            bool throwIfNotFound) const throw (Exception)
 {
+    Q_ASSERT(child && (child->mParent == this));
     XmlDomElement* nextChild = const_cast<XmlDomElement*>(child);
     do
     {
-        int index = mChilds.indexOf(const_cast<XmlDomElement*>(nextChild));
-        Q_ASSERT(index > -1);
+        int index = nextChild->mIndex; // stored index -> no need to search the list
         if (index < mChilds.count()-1)
             nextChild = mChilds.at(index+1);
         else if (!throwIfNotFound)
@@ -751,41 +748,118 @@ XmlDomElement* XmlDomElement::getNextSibling(const QString& name, bool throwIfNo
 }
 
 /*****************************************************************************************
- *  QDomElement Converter Methods
+ *  Converter Methods
  ****************************************************************************************/
 
-QDomElement XmlDomElement::toQDomElement(QDomDocument& domDocument) const noexcept
+void XmlDomElement::writeToXmlStreamWriter(QXmlStreamWriter& writer) const noexcept
 {
-    QDomElement element = domDocument.createElement(mName);
+    // elements with an empty text are written as empty elements too, as the reader can
+    // not distinguish them (so parsing and saving again gives the same output)
+    if (hasChilds() || (!mText.isEmpty()))
+        writer.writeStartElement(mName);
+    else
+        writer.writeEmptyElement(mName);
+
+    QVector<const Attribute*> attributes;
+    attributes.reserve(mAttributes.count());
+    for (int i = 0; i < mAttributes.count(); ++i)
+        attributes.append(&mAttributes.at(i));
+    std::sort(attributes.begin(), attributes.end(),
+              [](const Attribute* a, const Attribute* b) {return a->name < b->name;});
+    foreach (const Attribute* attribute, attributes)
+        writer.writeAttribute(attribute->name, attribute->value);
 
     if (hasChilds())
     {
-        foreach (XmlDomElement* child, mChilds)
-            element.appendChild(child->toQDomElement(domDocument));
-    }
-    else if (!mText.isNull())
-    {
-        QDomText textNode = domDocument.createTextNode(mText);
-        element.appendChild(textNode);
+        foreach (const XmlDomElement* child, mChilds)
+            child->writeToXmlStreamWriter(writer);
+        writer.writeEndElement();
     }
-
-    foreach (const QString& key, mAttributes.keys())
+    else if (!mText.isEmpty())
     {
-        element.setAttribute(key, mAttributes.value(key));
+        writer.writeCharacters(mText);
+        writer.writeEndElement();
     }
-
-    return element;
 }
 
-XmlDomElement* XmlDomElement::fromQDomElement(QDomElement domElement, XmlDomDocument* doc) noexcept
+XmlDomElement* XmlDomElement::fromXmlStreamReader(QXmlStreamReader& reader,
+                                                  XmlDomDocument* doc) noexcept
 {
-    return new XmlDomElement(domElement, nullptr, doc);
+    Q_ASSERT(reader.isStartElement());
+
+    // Interning table for tag and attribute names: as QString is implicitly shared, all
+    // elements of the document use the same string data for equal names (e.g. "uuid"),
+    // instead of allocating the same name again for every element.
+    QSet<QString> names;
+    auto intern = [&names](const QStringRef& ref) {
+        QString name = ref.toString();
+        QSet<QString>::const_iterator it = names.constFind(name);
+        if (it != names.constEnd()) return *it;
+        names.insert(name);
+        return name;
+    };
+
+    QScopedPointer<XmlDomElement> root;
+    XmlDomElement* current = nullptr;
+    while (!reader.hasError())
+    {
+        switch (reader.tokenType())
+        {
+            case QXmlStreamReader::StartElement:
+            {
+                XmlDomElement* element = new XmlDomElement(intern(reader.qualifiedName()));
+                QXmlStreamAttributes attributes = reader.attributes();
+                element->mAttributes.reserve(attributes.count());
+                foreach (const QXmlStreamAttribute& attribute, attributes)
+                    element->mAttributes.append(Attribute{intern(attribute.qualifiedName()),
+                                                          attribute.value().toString()});
+                if (current) {
+                    element->mParent = current;
+                    element->mIndex = current->mChilds.count();
+                    current->mChilds.append(element);
+                } else {
+                    element->mDocument = doc;
+                    root.reset(element);
+                }
+                current = element;
+                break;
+            }
+
+            case QXmlStreamReader::Characters:
+                if (!reader.isWhitespace())
+                    current->mText.append(reader.text());
+                break;
+
+            case QXmlStreamReader::EndElement:
+                if (current->hasChilds())
+                    current->mText = QString(); // elements with childs cannot have a text
+                current = current->mParent;
+                if (!current)
+                    return root.take(); // end of the requested element reached
+                break;
+
+            default:
+                break; // ignore comments, processing instructions etc.
+        }
+        reader.readNext();
+    }
+    return nullptr;
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+int XmlDomElement::indexOfAttribute(const QString& name) const noexcept
+{
+    for (int i = 0; i < mAttributes.count(); ++i)
+    {
+        if (mAttributes.at(i).name == name)
+            return i;
+    }
+    return -1;
+}
+
 bool XmlDomElement::isValidXmlTagName(const QString& name) noexcept
 {
     bool valid = !name.isEmpty();
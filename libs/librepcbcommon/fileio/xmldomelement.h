@@ -24,7 +24,6 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
-#include <QDomElement>
 #include "../exceptions.h"
 #include "filepath.h"
 
@@ -203,6 +202,13 @@ class XmlDomElement final
          */
         bool hasAttribute(const QString& name) const noexcept;
 
+        /**
+         * @brief Remove an attribute from this element (if it exists)
+         *
+         * @param name  The tag name (see #isValidXmlTagName() for allowed characters)
+         */
+        void removeAttribute(const QString& name) noexcept;
+
         /**
          * @brief Get the value of a specific attribute in the specified type
          *
@@ -413,31 +419,54 @@ class XmlDomElement final
                                       bool throwIfNotFound = false) const throw (Exception);
 
 
-        // QDomElement Converter Methods
+        // Converter Methods
 
         /**
-         * @brief Construct a QDomElement object from this XmlDomElement (recursively)
+         * @brief Write this XmlDomElement (recursively) to a QXmlStreamWriter
          *
-         * @param domDocument   The DOM Document of the newly created QDomElement
+         * The attributes are written in alphabetical order to get the same output for
+         * the same DOM tree on every save (important for version control systems).
          *
-         * @return The created QDomElement (which is added to the specified DOM document)
+         * @param writer        The writer to append the element to
          */
-        QDomElement toQDomElement(QDomDocument& domDocument) const noexcept;
+        void writeToXmlStreamWriter(QXmlStreamWriter& writer) const noexcept;
 
         /**
-         * @brief Construct a XmlDomElement object from a QDomElement object (recursively)
+         * @brief Construct a XmlDomElement tree directly from a QXmlStreamReader
+         *
+         * This reads the XML in a single pass without building an intermediate DOM tree.
+         * Whitespace-only text is ignored and the text of elements with childs is
+         * discarded (the same behaviour as QDomDocument had).
          *
-         * @param domElement    The QDomElement to copy
+         * @param reader        The reader which must be positioned at the start element
+         *                      to read. After returning, it is positioned at the
+         *                      corresponding end element (or at the error).
          * @param doc           The DOM Document of the newly created XmlDomElement (only
          *                      needed for the root element)
          *
-         * @return The created XmlDomElement (the caller takes the ownership!)
+         * @retval XmlDomElement*   The created XmlDomElement (the caller takes the ownership!)
+         * @retval nullptr          If the reader has reported an error
          */
-        static XmlDomElement* fromQDomElement(QDomElement domElement, XmlDomDocument* doc = nullptr) noexcept;
+        static XmlDomElement* fromXmlStreamReader(QXmlStreamReader& reader,
+                                                  XmlDomDocument* doc = nullptr) noexcept;
 
 
     private:
 
+        // Types
+
+        /**
+         * @brief An attribute of an element
+         *
+         * Elements have only a few attributes, so a flat vector of name/value pairs is
+         * smaller and (for lookups) not slower than a hash table.
+         */
+        struct Attribute {
+            QString name;   ///< the attribute name (shared between elements, see fromXmlStreamReader())
+            QString value;  ///< the attribute value
+        };
+
+
         // make some methods inaccessible...
         XmlDomElement() = delete;
         XmlDomElement(const XmlDomElement& other) = delete;
@@ -446,17 +475,6 @@ class XmlDomElement final
 
         // Private Methods
 
-        /**
-         * @brief Private constructor to create a XmlDomElement from a QDomElement
-         *
-         * @param domElement    The QDomElement to copy
-         * @param parent        The parent of the newly created XmlDomElement
-         * @param doc           The DOM Document of the newly created XmlDomElement (only
-         *                      needed for the root element)
-         */
-        explicit XmlDomElement(QDomElement domElement, XmlDomElement* parent = nullptr,
-                               XmlDomDocument* doc = nullptr) noexcept;
-
         /**
          * @brief Check if a QString represents a valid XML tag name for elements and attributes
          *
@@ -472,14 +490,24 @@ class XmlDomElement final
          */
         static bool isValidXmlTagName(const QString& name) noexcept;
 
+        /**
+         * @brief Get the index of an attribute in #mAttributes
+         *
+         * @param name  The name of the attribute
+         *
+         * @return The index of the attribute (-1 if there is no such attribute)
+         */
+        int indexOfAttribute(const QString& name) const noexcept;
+
 
         // Attributes
         XmlDomDocument* mDocument;  ///< the DOM document of the tree (only needed in the root node, otherwise nullptr)
         XmlDomElement* mParent;     ///< the parent element (if available, otherwise nullptr)
+        int mIndex;                 ///< the index of this element in mParent->mChilds (-1 if there is no parent)
         QString mName;              ///< the tag name of this element
         QString mText;              ///< the text of this element (only if there are no childs)
         QList<XmlDomElement*> mChilds;      ///< all child elements (only if there is no text)
-        QHash<QString, QString> mAttributes;///< all attributes of this element (key, value) in arbitrary order
+        QVector<Attribute> mAttributes;     ///< all attributes of this element in arbitrary order
 };
 
 /*****************************************************************************************
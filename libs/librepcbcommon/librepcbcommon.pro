@@ -51,6 +51,8 @@ HEADERS += \
     debug.h \
     exceptions.h \
     gridproperties.h \
+    airwiresbuilder.h \
+    clearancechecker.h \
     if_attributeprovider.h \
     schematiclayer.h \
     systeminfo.h \
@@ -103,6 +105,8 @@ SOURCES += \
     debug.cpp \
     exceptions.cpp \
     gridproperties.cpp \
+    airwiresbuilder.cpp \
+    clearancechecker.cpp \
     if_attributeprovider.cpp \
     schematiclayer.cpp \
     systeminfo.cpp \
@@ -42,6 +42,17 @@ UndoCommand::~UndoCommand() noexcept
     Q_ASSERT(qAbs(mRedoCount - mUndoCount) <= 1);
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 UndoCommand::getApproxMemoryUsage() const noexcept
+{
+    // the size of the derived object is unknown here, so just assume some bytes for the
+    // object itself and its (small) heap allocated members
+    return 256 + mText.capacity() * sizeof(QChar);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -79,6 +90,41 @@ void UndoCommand::redo() throw (Exception)
     mRedoCount++;
 }
 
+bool UndoCommand::mergeWith(const UndoCommand& other) noexcept
+{
+    if (!canMergeWith(other)) {
+        return false;
+    }
+    return performMergeWith(other);
+}
+
+bool UndoCommand::canMergeWith(const UndoCommand& other) const noexcept
+{
+    if ((&other == this) || (getMergeId() < 0) || (other.getMergeId() != getMergeId())) {
+        return false;
+    }
+    if ((!isCurrentlyExecuted()) || (!other.isCurrentlyExecuted())) {
+        return false;
+    }
+    return performCanMergeWith(other);
+}
+
+/*****************************************************************************************
+ *  Protected Methods
+ ****************************************************************************************/
+
+bool UndoCommand::performCanMergeWith(const UndoCommand& other) const noexcept
+{
+    Q_UNUSED(other);
+    return true;
+}
+
+bool UndoCommand::performMergeWith(const UndoCommand& other) noexcept
+{
+    Q_UNUSED(other);
+    return false;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
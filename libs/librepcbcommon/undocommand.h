@@ -81,6 +81,30 @@ class UndoCommand
          */
         bool isCurrentlyExecuted() const noexcept {return mRedoCount > mUndoCount;}
 
+        /**
+         * @brief Get the approximate count of bytes allocated by this command
+         *
+         * This is used by librepcb::UndoStack to limit its memory usage, so only memory
+         * which is freed when the command is deleted must be counted. The default
+         * implementation returns a rough estimate for a typical command object. Commands
+         * which own a lot of data should reimplement this method.
+         *
+         * @note Board and schematic items (e.g. removed traces) are only referenced by
+         *       the commands, not owned (they are not deleted together with the
+         *       command), so they are not counted.
+         *
+         * @note The value must not change after the command was executed the first time.
+         */
+        virtual qint64 getApproxMemoryUsage() const noexcept;
+
+        /**
+         * @brief Get the merge ID of this command (see #mergeWith())
+         *
+         * @return -1 if this command cannot be merged with other commands (default),
+         *         otherwise an ID which is unique for the command type
+         */
+        virtual int getMergeId() const noexcept {return -1;}
+
 
         // General Methods
 
@@ -102,6 +126,32 @@ class UndoCommand
          */
         virtual void redo() throw (Exception) final;
 
+        /**
+         * @brief Try to merge another command into this command
+         *
+         * This is used by librepcb::UndoStack to collapse consecutive edits of the same
+         * object (e.g. moving a device in small steps) into a single command. Both
+         * commands must be currently executed and have the same merge ID (see
+         * #getMergeId()).
+         *
+         * @param other     The command executed directly after this command
+         *
+         * @retval true     If "other" was merged: Undoing/redoing this command now also
+         *                  undoes/redoes the changes of "other", so "other" must be
+         *                  deleted without undoing it.
+         * @retval false    If the commands cannot be merged (nothing was changed)
+         */
+        bool mergeWith(const UndoCommand& other) noexcept;
+
+        /**
+         * @brief Check whether #mergeWith() would succeed, without changing anything
+         *
+         * @param other     The command executed directly after this command
+         *
+         * @return true if #mergeWith() would merge "other", false if not
+         */
+        bool canMergeWith(const UndoCommand& other) const noexcept;
+
         // Operator Overloadings
         UndoCommand& operator=(const UndoCommand& rhs) = delete;
 
@@ -134,6 +184,32 @@ class UndoCommand
          */
         virtual void performRedo() throw (Exception) = 0;
 
+        /**
+         * @brief Check whether another command can be merged into this command
+         *
+         * @note Derived classes which can not merge every command with the same merge ID
+         *       must implement this method. The default implementation returns true.
+         *
+         * @param other     The command to check (same merge ID, already executed)
+         *
+         * @return true if #performMergeWith() would succeed, false if not
+         */
+        virtual bool performCanMergeWith(const UndoCommand& other) const noexcept;
+
+        /**
+         * @brief Merge another command into this command
+         *
+         * @note Derived classes which return a merge ID with #getMergeId() must
+         *       implement this method. The default implementation returns false. It is
+         *       only called if #performCanMergeWith() returned true.
+         *
+         * @param other     The command to merge (same merge ID, already executed)
+         *
+         * @retval true     If the command was merged
+         * @retval false    If the command cannot be merged
+         */
+        virtual bool performMergeWith(const UndoCommand& other) noexcept;
+
 
     private:
 
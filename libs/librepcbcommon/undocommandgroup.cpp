@@ -34,7 +34,7 @@ namespace librepcb {
  ****************************************************************************************/
 
 UndoCommandGroup::UndoCommandGroup(const QString& text) noexcept :
-    UndoCommand(text)
+    UndoCommand(text), mChildsMemoryUsage(0)
 {
 }
 
@@ -46,6 +46,16 @@ UndoCommandGroup::~UndoCommandGroup() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 UndoCommandGroup::getApproxMemoryUsage() const noexcept
+{
+    return UndoCommand::getApproxMemoryUsage() + mChildsMemoryUsage
+         + mChilds.count() * sizeof(UndoCommand*);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -63,6 +73,7 @@ void UndoCommandGroup::appendChild(UndoCommand* cmd) throw (Exception)
         cmd->execute(); // can throw
     }
 
+    mChildsMemoryUsage += cmd->getApproxMemoryUsage();
     mChilds.append(cmdScopeGuard.take());
 }
 
@@ -117,6 +128,7 @@ void UndoCommandGroup::execNewChildCmd(UndoCommand* cmd) throw (Exception)
     }
 
     cmdScopeGuard->execute(); // can throw
+    mChildsMemoryUsage += cmd->getApproxMemoryUsage();
     mChilds.append(cmdScopeGuard.take());
 }
 
@@ -57,6 +57,9 @@ class UndoCommandGroup : public UndoCommand
         // Getters
         int getChildCount() const noexcept {return mChilds.count();}
 
+        /// @copydoc UndoCommand::getApproxMemoryUsage()
+        virtual qint64 getApproxMemoryUsage() const noexcept override;
+
         // General Methods
 
         /**
@@ -104,6 +107,14 @@ class UndoCommandGroup : public UndoCommand
          * is at the top of the list.
          */
         QList<UndoCommand*> mChilds;
+
+        /**
+         * @brief The sum of UndoCommand#getApproxMemoryUsage() of all #mChilds
+         *
+         * Updated when a child is added, so the memory usage of huge groups (e.g. moving
+         * thousands of items) can be determined without iterating over all childs.
+         */
+        qint64 mChildsMemoryUsage;
 };
 
 /*****************************************************************************************
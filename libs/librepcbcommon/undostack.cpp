@@ -36,7 +36,9 @@ namespace librepcb {
  ****************************************************************************************/
 
 UndoStack::UndoStack() noexcept :
-    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr)
+    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr),
+    mMaxDepth(1000), mMemoryBudget(128 * 1024 * 1024), mMergeWindowMs(2000),
+    mLastCommandTimer()
 {
 }
 
@@ -85,6 +87,15 @@ bool UndoStack::isCommandGroupActive() const noexcept
     return (mActiveCommandGroup != nullptr);
 }
 
+qint64 UndoStack::getMemoryUsage() const noexcept
+{
+    qint64 bytes = 0;
+    foreach (const UndoCommand* cmd, mCommands) {
+        bytes += cmd->getApproxMemoryUsage();
+    }
+    return bytes;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -98,6 +109,23 @@ void UndoStack::setClean() noexcept
     emit cleanChanged(true);
 }
 
+void UndoStack::setMaxDepth(int depth) noexcept
+{
+    mMaxDepth = qMax(depth, 0);
+    evictOldCommands();
+}
+
+void UndoStack::setMemoryBudget(qint64 bytes) noexcept
+{
+    mMemoryBudget = qMax(bytes, qint64(0));
+    evictOldCommands();
+}
+
+void UndoStack::setMergeWindow(int milliseconds) noexcept
+{
+    mMergeWindowMs = qMax(milliseconds, 0);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -114,7 +142,11 @@ void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) throw (Exception)
 
     bool commandHasDoneSomething = cmd->execute(); // can throw
 
-    if (commandHasDoneSomething || forceKeepCmd) {
+    if (commandHasDoneSomething && (!forceKeepCmd) && mergeWithTopCommand(*cmd)) {
+        // the top command now contains the changes of "cmd", so we can delete it
+        // (the undo/redo texts and states did not change, thus no signals are emitted)
+        mLastCommandTimer.start();
+    } else if (commandHasDoneSomething || forceKeepCmd) {
         // the clean state will no longer exist -> make the index invalid
         if (mCleanIndex > mCurrentIndex) {
             mCleanIndex = -1;
@@ -137,6 +169,12 @@ void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) throw (Exception)
         emit canUndoChanged(true);
         emit canRedoChanged(false);
         emit cleanChanged(false);
+        mLastCommandTimer.start();
+
+        // a command group gets evicted when it is committed (its size is not known yet)
+        if (!forceKeepCmd) {
+            evictOldCommands();
+        }
     } else {
         // the command has done nothing, so we will just discard it
         cmd->undo(); // only to be sure the command has executed nothing...
@@ -192,6 +230,7 @@ void UndoStack::commitCmdGroup() throw (Exception)
     // To finish the active command group, we only need to reset the pointer to the
     // currently active command group
     mActiveCommandGroup = nullptr;
+    evictOldCommands();
 
     // emit signals
     emit canUndoChanged(canUndo());
@@ -235,6 +274,7 @@ void UndoStack::undo() throw (Exception)
     try {
         mCommands[mCurrentIndex-1]->undo(); // can throw (but should usually not)
         mCurrentIndex--;
+        mLastCommandTimer.invalidate();
     } catch (Exception& e) {
         qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getUserMsg();
         throw;
@@ -257,6 +297,7 @@ void UndoStack::redo() throw (Exception)
     try {
         mCommands[mCurrentIndex]->redo(); // can throw (but should usually not)
         mCurrentIndex++;
+        mLastCommandTimer.invalidate();
     } catch (Exception& e) {
         qCritical() << "UndoCommand::redo() has thrown an exception:" << e.getUserMsg();
         throw;
@@ -292,6 +333,7 @@ void UndoStack::clear() noexcept
     mCurrentIndex = 0;
     mCleanIndex = 0;
     mActiveCommandGroup = nullptr;
+    mLastCommandTimer.invalidate();
 
     // emit signals
     emit undoTextChanged(tr("Undo"));
@@ -301,6 +343,54 @@ void UndoStack::clear() noexcept
     emit cleanChanged(true);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void UndoStack::evictOldCommands() noexcept
+{
+    if ((mMaxDepth == 0) && (mMemoryBudget == 0)) {
+        return;
+    }
+
+    qint64 memoryUsage = (mMemoryBudget > 0) ? getMemoryUsage() : 0;
+    while ((mCurrentIndex > 1) && (mCommands.first() != mActiveCommandGroup)) {
+        bool tooDeep = (mMaxDepth > 0) && (mCommands.count() > mMaxDepth);
+        bool tooBig = (mMemoryBudget > 0) && (memoryUsage > mMemoryBudget);
+        if ((!tooDeep) && (!tooBig)) {
+            break;
+        }
+
+        // the oldest command is executed, so deleting it does not affect the document
+        UndoCommand* cmd = mCommands.takeFirst();
+        memoryUsage -= cmd->getApproxMemoryUsage();
+        delete cmd;
+        mCurrentIndex--;
+        if (mCleanIndex > 0) {
+            mCleanIndex--;
+        } else {
+            mCleanIndex = -1; // the clean state is no longer reachable
+        }
+    }
+}
+
+bool UndoStack::mergeWithTopCommand(const UndoCommand& cmd) noexcept
+{
+    if ((mMergeWindowMs == 0) || (!mLastCommandTimer.isValid())) {
+        return false;
+    }
+    if (mLastCommandTimer.elapsed() > mMergeWindowMs) {
+        return false;
+    }
+    if ((mCurrentIndex == 0) || (mCurrentIndex != mCommands.count()) || isClean()) {
+        return false;
+    }
+    if (isCommandGroupActive()) {
+        return false;
+    }
+    return mCommands.last()->mergeWith(cmd);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -132,6 +132,34 @@ class UndoStack final : public QObject
          */
         bool isCommandGroupActive() const noexcept;
 
+        /**
+         * @brief Get the maximum count of commands in the stack (see #setMaxDepth())
+         *
+         * @return The maximum count of commands (0 = unlimited)
+         */
+        int getMaxDepth() const noexcept {return mMaxDepth;}
+
+        /**
+         * @brief Get the memory budget of the stack (see #setMemoryBudget())
+         *
+         * @return The maximum memory usage in bytes (0 = unlimited)
+         */
+        qint64 getMemoryBudget() const noexcept {return mMemoryBudget;}
+
+        /**
+         * @brief Get the approximate memory usage of all commands in the stack
+         *
+         * @return The sum of UndoCommand#getApproxMemoryUsage() of all commands (bytes)
+         */
+        qint64 getMemoryUsage() const noexcept;
+
+        /**
+         * @brief Get the merge window (see #setMergeWindow())
+         *
+         * @return The merge window in milliseconds (0 = merging disabled)
+         */
+        int getMergeWindow() const noexcept {return mMergeWindowMs;}
+
 
         // Setters
 
@@ -140,6 +168,40 @@ class UndoStack final : public QObject
          */
         void setClean() noexcept;
 
+        /**
+         * @brief Limit the count of commands in the stack
+         *
+         * If the stack contains more commands, the oldest commands are deleted (see
+         * #evictOldCommands()).
+         *
+         * @param depth     The maximum count of commands (0 = unlimited)
+         */
+        void setMaxDepth(int depth) noexcept;
+
+        /**
+         * @brief Limit the approximate memory usage of the stack
+         *
+         * If the stack uses more memory, the oldest commands are deleted (see
+         * #evictOldCommands()). The memory usage is the sum of
+         * UndoCommand#getApproxMemoryUsage() of all commands, so it only covers the
+         * command objects themselves (e.g. large command groups), not the board and
+         * schematic items referenced by them.
+         *
+         * @param bytes     The maximum memory usage in bytes (0 = unlimited)
+         */
+        void setMemoryBudget(qint64 bytes) noexcept;
+
+        /**
+         * @brief Set the time window for merging consecutive commands
+         *
+         * If a command is executed with #execCmd() within this time after the previous
+         * command, and both commands have the same merge ID, the new command is merged
+         * into the previous one (see UndoCommand#mergeWith()) instead of being pushed.
+         *
+         * @param milliseconds  The merge window in milliseconds (0 = merging disabled)
+         */
+        void setMergeWindow(int milliseconds) noexcept;
+
 
         // General Methods
 
@@ -250,6 +312,29 @@ class UndoStack final : public QObject
 
     private:
 
+        /**
+         * @brief Delete the oldest commands until #mMaxDepth and #mMemoryBudget are met
+         *
+         * Only already executed commands below #mCurrentIndex are deleted, and the newest
+         * executed command is always kept, so undoing the last change is always possible.
+         * If the clean state gets deleted, it becomes unreachable (#mCleanIndex = -1).
+         */
+        void evictOldCommands() noexcept;
+
+        /**
+         * @brief Try to merge an executed command into the command on top of the stack
+         *
+         * Merging is only done within #mMergeWindowMs, if there are no commands to redo
+         * and if the top command is not the clean state (otherwise the clean state would
+         * contain the changes of the merged command).
+         *
+         * @param cmd       The executed command (not yet pushed to the stack)
+         *
+         * @return True if merged (then "cmd" must be deleted), false otherwise
+         */
+        bool mergeWithTopCommand(const UndoCommand& cmd) noexcept;
+
+
         /**
          * @brief This list holds all commands of the undo stack
          *
@@ -279,6 +364,29 @@ class UndoStack final : public QObject
          * or #abortCmdGroup(). Otherwise, the variable contains the nullptr.
          */
         UndoCommandGroup* mActiveCommandGroup;
+
+        /**
+         * @brief The maximum count of commands in #mCommands (0 = unlimited)
+         */
+        int mMaxDepth;
+
+        /**
+         * @brief The maximum approximate memory usage of #mCommands in bytes (0 = unlimited)
+         */
+        qint64 mMemoryBudget;
+
+        /**
+         * @brief The time window for merging commands in milliseconds (0 = disabled)
+         */
+        int mMergeWindowMs;
+
+        /**
+         * @brief Measures the time since the last command was pushed or merged
+         *
+         * It is invalidated by all other operations (undo, redo, ...) to avoid merging
+         * commands which are not consecutive from the user's point of view.
+         */
+        QElapsedTimer mLastCommandTimer;
 };
 
 /*****************************************************************************************
@@ -28,18 +28,56 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QString Uuid::toStr() const noexcept
+{
+    if (isNull()) return QString();
+
+    static const char lowerHexDigits[] = "0123456789abcdef";
+    static const char upperHexDigits[] = "0123456789ABCDEF";
+    QString str(36, QChar('-'));
+    QChar* data = str.data();
+    int pos = 0;
+    for (int i = 0; i < 32; ++i) {
+        if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+            ++pos; // skip the dash
+        }
+        quint64 part = (i < 16) ? mHigh : mLow;
+        int shift = 60 - 4 * (i % 16);
+        const char* hexDigits = (mUpperCaseDigits & (1u << i)) ? upperHexDigits : lowerHexDigits;
+        data[pos++] = QLatin1Char(hexDigits[(part >> shift) & 0xF]);
+    }
+    return str;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
 
 bool Uuid::setUuid(const QString& uuid) noexcept
 {
-    QUuid quuid(uuid);
     if (uuid.length() != 36)                return false; // do NOT accept '{' and '}'
+    QUuid quuid(uuid);
     if (quuid.isNull())                     return false;
     if (quuid.variant() != QUuid::DCE)      return false;
     if (quuid.version() != QUuid::Random)   return false;
-    mUuid = uuid;
+    mHigh = (quint64(quuid.data1) << 32) | (quint64(quuid.data2) << 16) | quint64(quuid.data3);
+    mLow = 0;
+    for (int i = 0; i < 8; ++i) {
+        mLow = (mLow << 8) | quint64(quuid.data4[i]);
+    }
+    // remember the case of the digits to write them back exactly as they were read
+    mUpperCaseDigits = 0;
+    for (int pos = 0, i = 0; pos < uuid.length(); ++pos) {
+        if (uuid.at(pos) == QChar('-')) continue;
+        if ((uuid.at(pos) >= QChar('A')) && (uuid.at(pos) <= QChar('F'))) {
+            mUpperCaseDigits |= (1u << i);
+        }
+        ++i;
+    }
     return true;
 }
 
@@ -49,44 +87,46 @@ bool Uuid::setUuid(const QString& uuid) noexcept
 
 Uuid& Uuid::operator=(const Uuid& rhs) noexcept
 {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
+    mUpperCaseDigits = rhs.mUpperCaseDigits;
     return *this;
 }
 
 bool Uuid::operator==(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid == rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
 }
 
 bool Uuid::operator!=(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid != rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh != rhs.mHigh) || (mLow != rhs.mLow);
 }
 
 bool Uuid::operator<(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid < rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
 }
 
 bool Uuid::operator>(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid > rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh > rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow > rhs.mLow));
 }
 
 bool Uuid::operator<=(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid <= rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return !(*this > rhs);
 }
 
 bool Uuid::operator>=(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid >= rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return !(*this < rhs);
 }
 
 /*****************************************************************************************
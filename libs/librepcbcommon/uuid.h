@@ -37,11 +37,17 @@ namespace librepcb {
 /**
  * @brief The Uuid class is a replacement for QUuid to get UUID strings without {} braces
  *
+ * The UUID is stored as two 64-bit integers (most significant part first), so copying,
+ * comparing and hashing does not involve any string operations. The string
+ * representation is only parsed/generated when reading/writing files. The ordering of
+ * #Uuid objects is the same as the ordering of their (lowercase) string representation.
+ * The case of the hex digits is ignored for comparing and hashing, but #toStr() returns
+ * them in the same case as they were passed to #setUuid().
+ *
  * @author ubruhin
  * @date 2015-09-29
  *
  * @todo Check if this class works properly on all operating systems
- * @todo Add unit tests
  */
 class Uuid final
 {
@@ -52,21 +58,23 @@ class Uuid final
         /**
          * @brief Default constructor (creates a NULL #Uuid object)
          */
-        Uuid() noexcept : mUuid() {}
+        Uuid() noexcept : mHigh(0), mLow(0), mUpperCaseDigits(0) {}
 
         /**
          * @brief Constructor which creates a #Uuid object from a string
          *
          * @param uuid      The uuid as a string (without braces)
          */
-        explicit Uuid(const QString& uuid) noexcept : mUuid() {setUuid(uuid);}
+        explicit Uuid(const QString& uuid) noexcept :
+            mHigh(0), mLow(0), mUpperCaseDigits(0) {setUuid(uuid);}
 
         /**
          * @brief Copy constructor
          *
          * @param other     Another #Uuid object
          */
-        Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+        Uuid(const Uuid& other) noexcept :
+            mHigh(other.mHigh), mLow(other.mLow), mUpperCaseDigits(other.mUpperCaseDigits) {}
 
         /**
          * Destructor
@@ -81,14 +89,14 @@ class Uuid final
          *
          * @return true if NULL/invalid UUID, false if valid UUID
          */
-        bool isNull() const noexcept {return mUuid.isEmpty();}
+        bool isNull() const noexcept {return (mHigh == 0) && (mLow == 0);}
 
         /**
          * @brief Get the UUID as a string (without braces)
          *
-         * @return The UUID as a string
+         * @return The UUID as a string (with the same case as passed to #setUuid())
          */
-        QString toStr() const noexcept {return mUuid;}
+        QString toStr() const noexcept;
 
 
         // Setters
@@ -134,16 +142,22 @@ class Uuid final
     private:
 
         // Private Attributes
-        QString mUuid;
+        quint64 mHigh;  ///< the first 8 bytes of the UUID (0 if NULL)
+        quint64 mLow;   ///< the last 8 bytes of the UUID (0 if NULL)
+        quint32 mUpperCaseDigits; ///< bit i is set if the i-th hex digit is uppercase
+
+        // Friends
+        friend uint qHash(const Uuid& key, uint seed) noexcept;
 };
 
 /*****************************************************************************************
  *  Non-Member Functions
  ****************************************************************************************/
 
-inline uint qHash(const Uuid& key, uint seed)
+inline uint qHash(const Uuid& key, uint seed) noexcept
 {
-    return qHash(key.toStr(), seed);
+    // random UUIDs are uniformly distributed, so folding both halves is sufficient
+    return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 inline QDataStream& operator<<(QDataStream& stream, const Uuid& uuid)
@@ -23,8 +23,7 @@
 #include <QtCore>
 #include "categorytreeitem.h"
 #include "../library.h"
-#include "componentcategory.h"
-#include "packagecategory.h"
+#include "../librarybaseelement.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -37,46 +36,18 @@ namespace library {
  ****************************************************************************************/
 
 CategoryTreeItem::CategoryTreeItem(const Library& library, const QStringList localeOrder,
-                                   CategoryTreeItem* parent, const Uuid& uuid) noexcept :
-    mLocaleOrder(localeOrder), mParent(parent), mUuid(uuid), mCategory(nullptr),
-    mDepth(parent ? parent->getDepth() + 1 : 0), mExceptionMessage()
+                                   CategoryTreeItem* parent, const Uuid& uuid,
+                                   const QString& name, const QString& description,
+                                   bool hasChilds) noexcept :
+    mLibrary(library), mLocaleOrder(localeOrder), mParent(parent), mUuid(uuid),
+    mName(name), mDescription(description), mDepth(parent ? parent->getDepth() + 1 : 0),
+    mExceptionMessage(), mHasChilds(hasChilds), mChildsFetched(false)
 {
-    try
-    {
-        if (!mUuid.isNull())
-        {
-            FilePath fp = library.getLatestComponentCategory(mUuid);
-            if (fp.isValid()) mCategory = new ComponentCategory(fp, true);
-        }
-
-        if ((!mUuid.isNull()) || (!mParent))
-        {
-            QSet<Uuid> childs = library.getComponentCategoryChilds(mUuid);
-            foreach (const Uuid& childUuid, childs)
-                mChilds.append(new CategoryTreeItem(library, mLocaleOrder, this, childUuid));
-
-            // sort childs
-            qSort(mChilds.begin(), mChilds.end(),
-                  [](const CategoryTreeItem* a, const CategoryTreeItem* b)
-                  {return a->data(Qt::DisplayRole) < b->data(Qt::DisplayRole);});
-        }
-
-        if (!mParent)
-        {
-            // add category for elements without category
-            mChilds.append(new CategoryTreeItem(library, mLocaleOrder, this, Uuid()));
-        }
-    }
-    catch (Exception& e)
-    {
-        mExceptionMessage = e.getUserMsg();
-    }
 }
 
 CategoryTreeItem::~CategoryTreeItem() noexcept
 {
     qDeleteAll(mChilds);        mChilds.clear();
-    delete mCategory;           mCategory = nullptr;
 }
 
 /*****************************************************************************************
@@ -98,10 +69,8 @@ QVariant CategoryTreeItem::data(int role) const noexcept
         case Qt::DisplayRole:
             if (mUuid.isNull())
                 return "(Without Category)";
-            else if (mCategory)
-                return mCategory->getName(mLocaleOrder);
             else
-                return "(ERROR)";
+                return mName;
 
         case Qt::DecorationRole:
             break;
@@ -113,10 +82,10 @@ QVariant CategoryTreeItem::data(int role) const noexcept
         case Qt::ToolTipRole:
             if (mUuid.isNull())
                 return "All library elements without a category";
-            else if (mCategory)
-                return mCategory->getDescription(mLocaleOrder);
-            else
+            else if (!mExceptionMessage.isEmpty())
                 return mExceptionMessage;
+            else
+                return mDescription;
 
         case Qt::UserRole:
             return mUuid.toStr();
@@ -127,6 +96,70 @@ QVariant CategoryTreeItem::data(int role) const noexcept
     return QVariant();
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QList<CategoryTreeItem*> CategoryTreeItem::fetchChilds() noexcept
+{
+    QList<CategoryTreeItem*> childs;
+    if (!canFetchMore()) return childs;
+
+    try
+    {
+        QList<Library::CategoryMetadata> categories =
+            mLibrary.getComponentCategoryChildsMetadata(mUuid);
+        foreach (const Library::CategoryMetadata& cat, categories)
+        {
+            QString name = localeString(cat.names);
+            if (name.isNull()) name = "(ERROR)";
+            childs.append(new CategoryTreeItem(mLibrary, mLocaleOrder, this, cat.uuid, name,
+                                               localeString(cat.descriptions),
+                                               cat.childCount > 0));
+        }
+
+        // sort childs
+        qSort(childs.begin(), childs.end(),
+              [](const CategoryTreeItem* a, const CategoryTreeItem* b)
+              {return a->mName < b->mName;});
+    }
+    catch (Exception& e)
+    {
+        mExceptionMessage = e.getUserMsg();
+    }
+
+    if (!mParent)
+    {
+        // add category for elements without category
+        childs.append(new CategoryTreeItem(mLibrary, mLocaleOrder, this, Uuid(),
+                                           QString(), QString(), false));
+    }
+    return childs;
+}
+
+void CategoryTreeItem::setChilds(const QList<CategoryTreeItem*>& childs) noexcept
+{
+    Q_ASSERT(mChilds.isEmpty());
+    mChilds = childs;
+    mChildsFetched = true;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QString CategoryTreeItem::localeString(const QMap<QString, QString>& list) const noexcept
+{
+    try
+    {
+        return LibraryBaseElement::localeStringFromList(list, mLocaleOrder);
+    }
+    catch (const Exception&)
+    {
+        return QString();
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -34,8 +34,6 @@ namespace librepcb {
 namespace library {
 
 class Library;
-class ComponentCategory;
-class PackageCategory;
 
 /*****************************************************************************************
  *  Class CategoryTreeItem
@@ -43,6 +41,10 @@ class PackageCategory;
 
 /**
  * @brief The CategoryTreeItem class
+ *
+ * The child items are not loaded in the constructor, but only on demand with
+ * #fetchChilds() (see CategoryTreeModel#fetchMore()). All data is taken from the
+ * library cache, no category XML files are parsed.
  */
 class CategoryTreeItem final
 {
@@ -50,7 +52,8 @@ class CategoryTreeItem final
 
         // Constructors / Destructor
         CategoryTreeItem(const Library& library, const QStringList localeOrder,
-                         CategoryTreeItem* parent, const Uuid& uuid) noexcept;
+                         CategoryTreeItem* parent, const Uuid& uuid, const QString& name,
+                         const QString& description, bool hasChilds) noexcept;
         ~CategoryTreeItem() noexcept;
 
         // Getters
@@ -61,8 +64,26 @@ class CategoryTreeItem final
         CategoryTreeItem* getChild(int index)   const noexcept {return mChilds.value(index);}
         int getChildCount()                     const noexcept{return mChilds.count();}
         int getChildNumber()                    const noexcept;
+        bool hasChilds()                        const noexcept {return mHasChilds;}
+        bool canFetchMore()                     const noexcept {return mHasChilds && (!mChildsFetched);}
         QVariant data(int role) const noexcept;
 
+        // General Methods
+
+        /**
+         * @brief Load the child items from the library (without adding them yet)
+         *
+         * @return The new child items (sorted by name), to be added with #setChilds()
+         */
+        QList<CategoryTreeItem*> fetchChilds() noexcept;
+
+        /**
+         * @brief Set the child items which were loaded with #fetchChilds()
+         *
+         * @param childs    The child items (the ownership is taken)
+         */
+        void setChilds(const QList<CategoryTreeItem*>& childs) noexcept;
+
     private:
 
         // make some methods inaccessible...
@@ -70,13 +91,20 @@ class CategoryTreeItem final
         CategoryTreeItem(const CategoryTreeItem& other);
         CategoryTreeItem& operator=(const CategoryTreeItem& rhs);
 
+        // Private Methods
+        QString localeString(const QMap<QString, QString>& list) const noexcept;
+
         // Attributes
+        const Library& mLibrary;
         QStringList mLocaleOrder;
         CategoryTreeItem* mParent;
         Uuid mUuid;
-        ComponentCategory* mCategory;
+        QString mName;
+        QString mDescription;
         unsigned int mDepth; ///< this is to avoid endless recursion in the parent-child relationship
         QString mExceptionMessage;
+        bool mHasChilds;
+        bool mChildsFetched;
         QList<CategoryTreeItem*> mChilds;
 };
 
@@ -39,7 +39,9 @@ namespace library {
 CategoryTreeModel::CategoryTreeModel(const Library& library, const QStringList& localeOrder) noexcept :
     QAbstractItemModel(nullptr)
 {
-    mRootItem = new CategoryTreeItem(library, localeOrder, nullptr, Uuid());
+    mRootItem = new CategoryTreeItem(library, localeOrder, nullptr, Uuid(), QString(),
+                                     QString(), true);
+    mRootItem->setChilds(mRootItem->fetchChilds()); // load top level categories
 }
 
 CategoryTreeModel::~CategoryTreeModel() noexcept
@@ -110,6 +112,31 @@ QVariant CategoryTreeModel::data(const QModelIndex& index, int role) const
     return item->data(role);
 }
 
+bool CategoryTreeModel::hasChildren(const QModelIndex& parent) const
+{
+    CategoryTreeItem* item = getItem(parent);
+    return (item->getChildCount() > 0) || item->canFetchMore();
+}
+
+bool CategoryTreeModel::canFetchMore(const QModelIndex& parent) const
+{
+    CategoryTreeItem* item = getItem(parent);
+    return item->canFetchMore();
+}
+
+void CategoryTreeModel::fetchMore(const QModelIndex& parent)
+{
+    CategoryTreeItem* item = getItem(parent);
+    QList<CategoryTreeItem*> childs = item->fetchChilds();
+    if (childs.isEmpty()) {
+        item->setChilds(childs);
+        return;
+    }
+    beginInsertRows(parent, 0, childs.count() - 1);
+    item->setChilds(childs);
+    endInsertRows();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -40,6 +40,9 @@ class CategoryTreeItem;
 
 /**
  * @brief The CategoryTreeModel class
+ *
+ * Child categories are loaded lazily when their parent gets expanded (see
+ * #canFetchMore() and #fetchMore()).
  */
 class CategoryTreeModel final : public QAbstractItemModel
 {
@@ -58,6 +61,9 @@ class CategoryTreeModel final : public QAbstractItemModel
         virtual QModelIndex parent(const QModelIndex& index) const;
         virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
         virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+        virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+        virtual bool canFetchMore(const QModelIndex& parent) const;
+        virtual void fetchMore(const QModelIndex& parent);
 
 
     private:
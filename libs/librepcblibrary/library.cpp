@@ -22,7 +22,9 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtSql>
+#include <QtConcurrent>
 #include <librepcbcommon/exceptions.h>
+#include <librepcbcommon/scopeguard.h>
 #include <librepcbcommon/fileio/filepath.h>
 #include <librepcbcommon/fileio/smartxmlfile.h>
 #include <librepcbcommon/fileio/xmldomdocument.h>
@@ -33,6 +35,7 @@
 #include "pkg/package.h"
 #include "spcmdl/spicemodel.h"
 #include "cmp/component.h"
+#include "cmp/componentsymbolvariant.h"
 #include "dev/device.h"
 #include "library.h"
 
@@ -194,6 +197,27 @@ void Library::getPackageMetadata(const FilePath& pkgDir, QString* nameEn) const
     }
 }
 
+QList<Library::ComponentMetadata> Library::getComponentsMetadataByCategory(const Uuid& category) const throw (Exception)
+{
+    QList<ComponentMetadata> list;
+    QHash<Uuid, int> indexes; // only keep the latest version of each component
+    // all versions of the components in the category are fetched, so the same version
+    // is chosen regardless of the category in which the component is shown
+    foreach (const ComponentMetadata& metadata, getComponentsMetadata(
+        "uuid IN (SELECT components.uuid FROM components LEFT JOIN components_cat "
+        "ON components.id=components_cat.component_id WHERE category_uuid " %
+        (category.isNull() ? QString("IS NULL") : "= '" % category.toStr() % "'") % ")"))
+    {
+        if (!indexes.contains(metadata.uuid)) {
+            indexes.insert(metadata.uuid, list.count());
+            list.append(metadata);
+        } else if (metadata.version > list.at(indexes.value(metadata.uuid)).version) {
+            list[indexes.value(metadata.uuid)] = metadata;
+        }
+    }
+    return list;
+}
+
 /*****************************************************************************************
  *  Getters: Special
  ****************************************************************************************/
@@ -208,6 +232,16 @@ QSet<Uuid> Library::getPackageCategoryChilds(const Uuid& parent) const throw (Ex
     return getCategoryChilds("package_categories", parent);
 }
 
+QList<Library::CategoryMetadata> Library::getComponentCategoryChildsMetadata(const Uuid& parent) const throw (Exception)
+{
+    return getCategoryChildsMetadata("component_categories", parent);
+}
+
+QList<Library::CategoryMetadata> Library::getPackageCategoryChildsMetadata(const Uuid& parent) const throw (Exception)
+{
+    return getCategoryChildsMetadata("package_categories", parent);
+}
+
 QSet<Uuid> Library::getComponentsByCategory(const Uuid& category) const throw (Exception)
 {
     return getElementsByCategory("components", "component_id", category);
@@ -233,24 +267,214 @@ QSet<Uuid> Library::getDevicesOfComponent(const Uuid& component) const throw (Ex
     return elements;
 }
 
+QList<Library::SearchResult> Library::search(const QString& query, ElementTypes types,
+                                             const QStringList& localeOrder,
+                                             int limit) const throw (Exception)
+{
+    QStringList terms = query.split(QRegularExpression("\\s+"), QString::SkipEmptyParts);
+    if (terms.isEmpty() || (limit <= 0)) return QList<SearchResult>();
+
+    QHash<int, ElementTable> tables;
+    foreach (const ElementTable& table, getElementTables()) {
+        if (types.testFlag(table.type)) {
+            tables.insert(table.type, table);
+        }
+    }
+    if (tables.isEmpty()) return QList<SearchResult>();
+
+    // find the matching elements together with their UUID and filepath in a single
+    // query, sorted by relevance if possible
+    QStringList selects;
+    QHash<QString, QString> bindings;
+    if (isFullTextSearchAvailable()) {
+        QStringList ftsTerms;
+        foreach (QString term, terms) {
+            ftsTerms.append("\"" % term.replace("\"", "\"\"") % "\"*"); // prefix query
+        }
+        foreach (const ElementTable& table, tables) {
+            QString placeholder = QString(":query%1").arg(table.type);
+            selects.append(QString(
+                "SELECT %1 AS type, %2.id, %2.uuid, %2.filepath, search_index.rank AS rank "
+                "FROM search_index INNER JOIN %2 ON %2.id = search_index.element_id "
+                "WHERE search_index MATCH %3 AND search_index.element_type = %1")
+                .arg(table.type).arg(table.tablename, placeholder));
+            bindings.insert(placeholder, ftsTerms.join(" AND "));
+        }
+        selects.last().append(" ORDER BY rank"); // applies to the whole compound query
+    } else {
+        QStringList conditions;
+        for (int i = 0; i < terms.count(); ++i) {
+            // escape the LIKE wildcards, the terms must match literally
+            QString term = terms.at(i);
+            term.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+            conditions.append(QString("(IFNULL(tr.name, '') || ' ' || IFNULL(tr.description, '') "
+                                      "|| ' ' || IFNULL(tr.keywords, '')) LIKE :term%1 "
+                                      "ESCAPE '\\'").arg(i));
+            bindings.insert(QString(":term%1").arg(i), "%" % term % "%");
+        }
+        foreach (const ElementTable& table, tables) {
+            selects.append(QString(
+                "SELECT DISTINCT %1, %2.id, %2.uuid, %2.filepath FROM %2 "
+                "INNER JOIN %2_tr AS tr ON tr.%3 = %2.id WHERE %4")
+                .arg(table.type).arg(table.tablename, table.idRowName,
+                                     conditions.join(" AND ")));
+        }
+        selects.last().append(" LIMIT " % QString::number(limit));
+    }
+    QSqlQuery q = prepareQuery(selects.join(" UNION ALL "));
+    foreach (const QString& placeholder, bindings.keys()) {
+        q.bindValue(placeholder, bindings.value(placeholder));
+    }
+    execQuery(q, false);
+
+    QList<SearchResult> results;
+    QHash<int, QHash<int, int>> resultIndexes; // key: type, id; value: index in results
+    while ((results.count() < limit) && q.next()) {
+        int type = q.value(0).toInt();
+        int id = q.value(1).toInt();
+        if (resultIndexes[type].contains(id)) continue; // matched in another locale
+        Uuid uuid(q.value(2).toString());
+        if (uuid.isNull()) continue;
+
+        SearchResult result;
+        result.type = tables[type].type;
+        result.uuid = uuid;
+        result.filepath = FilePath::fromRelative(mLibPath, q.value(3).toString());
+        resultIndexes[type].insert(id, results.count());
+        results.append(result);
+    }
+
+    // get the names of the found elements in the requested locale (one query per type)
+    foreach (int type, resultIndexes.keys()) {
+        const ElementTable& table = tables[type];
+        const QHash<int, int>& indexes = resultIndexes[type];
+        QStringList ids;
+        foreach (int id, indexes.keys()) {
+            ids.append(QString::number(id));
+        }
+        QSqlQuery trQuery = prepareQuery(
+            "SELECT " % table.idRowName % ", locale, name FROM " % table.tablename % "_tr "
+            "WHERE name IS NOT NULL AND " % table.idRowName % " IN (" % ids.join(", ") % ")");
+        execQuery(trQuery, false);
+        QHash<int, QMap<QString, QString>> names;
+        while (trQuery.next()) {
+            names[trQuery.value(0).toInt()].insert(trQuery.value(1).toString(),
+                                                   trQuery.value(2).toString());
+        }
+        foreach (int id, indexes.keys()) {
+            const QMap<QString, QString>& list = names[id];
+            try {
+                results[indexes.value(id)].name =
+                    LibraryBaseElement::localeStringFromList(list, localeOrder);
+            } catch (const Exception&) {
+                // neither a requested locale nor "en_US" available
+                results[indexes.value(id)].name = list.isEmpty() ? QString() : list.first();
+            }
+        }
+    }
+    return results;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
-int Library::rescan() throw (Exception)
+int Library::rescan(RescanMode mode) throw (Exception)
 {
-    clearDatabaseAndCreateTables();
+    // The cache can be rebuilt from the library files at any time, so there's no need
+    // for a rollback journal on disk or for syncing the disk after each write.
+    QSqlQuery(mLibDatabase).exec("PRAGMA journal_mode = MEMORY");
+    QSqlQuery(mLibDatabase).exec("PRAGMA synchronous = OFF");
+    auto pragmaSg = scopeGuard([this](){
+        QSqlQuery(mLibDatabase).exec("PRAGMA synchronous = FULL");
+        QSqlQuery(mLibDatabase).exec("PRAGMA journal_mode = DELETE");
+    });
+
+    // write all modifications in a single transaction
+    if (!mLibDatabase.transaction()) {
+        throw RuntimeError(__FILE__, __LINE__, mLibDatabase.lastError().text(),
+            QString(tr("Could not start database transaction: %1"))
+            .arg(mLibDatabase.lastError().text()));
+    }
+    auto transactionSg = scopeGuard([this](){
+        mCachedQueries.clear();
+        mLibDatabase.rollback();
+    });
+
+    if ((mode == RescanMode::Full) || (getDatabaseSchemaVersion() != sDatabaseSchemaVersion)) {
+        clearDatabaseAndCreateTables();
+    }
+
+    // calculate the fingerprints of all element directories (in worker threads)
+    QList<ElementMetadata> dirs;
+    QMultiMap<QString, FilePath> dirPaths = getAllElementDirectories();
+    foreach (const ElementTable& table, getElementTables()) {
+        foreach (const FilePath& filepath, dirPaths.values(table.dirSuffix)) {
+            ElementMetadata element;
+            element.dirSuffix = table.dirSuffix;
+            element.filepath = filepath;
+            dirs.append(element);
+        }
+    }
+    dirs = QtConcurrent::blockingMapped(dirs, &Library::calcElementFingerprint);
 
+    // compare fingerprints with the database content to find modified elements
+    QList<ElementMetadata> modifiedElements;
+    QHash<QString, ElementTable> tables;
     int count = 0;
-    QMultiMap<QString, FilePath> dirs = getAllElementDirectories();
-    count += addCategoriesToDb<ComponentCategory>(  dirs.values("cmpcat"),  "component_categories", "cat_id");
-    count += addCategoriesToDb<PackageCategory>(    dirs.values("pkgcat"),  "package_categories",   "cat_id");
-    count += addElementsToDb<Symbol>(               dirs.values("sym"),     "symbols",              "symbol_id");
-    count += addElementsToDb<SpiceModel>(           dirs.values("spcmdl"),  "spice_models",         "model_id");
-    count += addElementsToDb<Package>(              dirs.values("pkg"),     "packages",             "package_id");
-    count += addElementsToDb<Component>(            dirs.values("cmp"),     "components",           "component_id");
-    count += addDevicesToDb(                        dirs.values("dev"),     "devices",              "device_id");
+    foreach (const ElementTable& table, getElementTables()) {
+        tables.insert(table.dirSuffix, table);
+        QHash<QString, QPair<int, QString>> dbElements = getFingerprintsFromDb(table);
+        foreach (const ElementMetadata& element, dirs) {
+            if (element.dirSuffix != table.dirSuffix) continue;
+            QString filepath = element.filepath.toRelative(mLibPath);
+            if (!dbElements.contains(filepath)) {
+                modifiedElements.append(element); // added element
+                continue;
+            }
+            QPair<int, QString> dbElement = dbElements.take(filepath);
+            if (dbElement.second != element.fingerprint) {
+                removeElementFromDb(table, dbElement.first);
+                modifiedElements.append(element); // modified element
+            } else {
+                count++; // unmodified element
+            }
+        }
+        foreach (const auto& dbElement, dbElements) {
+            removeElementFromDb(table, dbElement.first); // removed element
+        }
+    }
+
+    // parse modified elements in worker threads and add them to the database
+    QSharedPointer<Exception> error;
+    QFuture<ElementMetadata> future = QtConcurrent::mapped(modifiedElements,
+                                                           &Library::readElementMetadata);
+    for (int i = 0; i < modifiedElements.count(); ++i) {
+        ElementMetadata element = future.resultAt(i); // blocks until parsed
+        if (element.error) {
+            if (!error) error = element.error;
+            continue;
+        }
+        try {
+            addElementToDb(tables.value(element.dirSuffix), element);
+            count++;
+        } catch (...) {
+            future.cancel();
+            future.waitForFinished();
+            throw;
+        }
+    }
+
+    // commit the transaction (prepared statements must be finished before)
+    mCachedQueries.clear();
+    if (!mLibDatabase.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, mLibDatabase.lastError().text(),
+            QString(tr("Could not commit database transaction: %1"))
+            .arg(mLibDatabase.lastError().text()));
+    }
+    transactionSg.dismiss();
 
+    if (error) error->raise();
     return count;
 }
 
@@ -258,140 +482,159 @@ int Library::rescan() throw (Exception)
  *  Private Methods
  ****************************************************************************************/
 
-template <typename ElementType>
-int Library::addCategoriesToDb(const QList<FilePath>& dirs, const QString& tablename,
-                               const QString& id_rowname) throw (Exception)
+void Library::addElementToDb(const ElementTable& table,
+                             const ElementMetadata& element) throw (Exception)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs)
+    QString sql;
+    if (table.dirSuffix.endsWith("cat")) {
+        sql = "INSERT INTO " % table.tablename % " "
+              "(filepath, fingerprint, uuid, version, parent_uuid) VALUES "
+              "(:filepath, :fingerprint, :uuid, :version, :parent_uuid)";
+    } else if (table.dirSuffix == "dev") {
+        sql = "INSERT INTO " % table.tablename % " "
+              "(filepath, fingerprint, uuid, version, component_uuid, package_uuid) VALUES "
+              "(:filepath, :fingerprint, :uuid, :version, :component_uuid, :package_uuid)";
+    } else {
+        sql = "INSERT INTO " % table.tablename % " "
+              "(filepath, fingerprint, uuid, version) VALUES "
+              "(:filepath, :fingerprint, :uuid, :version)";
+    }
+    QSqlQuery& query = prepareCachedQuery(sql);
+    query.bindValue(":filepath",    element.filepath.toRelative(mLibPath));
+    query.bindValue(":fingerprint", element.fingerprint);
+    query.bindValue(":uuid",        element.uuid.toStr());
+    query.bindValue(":version",     element.version.toStr());
+    if (table.dirSuffix.endsWith("cat")) {
+        query.bindValue(":parent_uuid", element.parentUuid.isNull() ? QVariant(QVariant::String) : element.parentUuid.toStr());
+    } else if (table.dirSuffix == "dev") {
+        query.bindValue(":component_uuid",  element.componentUuid.toStr());
+        query.bindValue(":package_uuid",    element.packageUuid.toStr());
+    }
+    int id = execQuery(query, true);
+
+    QStringList locales;
+    locales.append(element.names.keys());
+    locales.append(element.descriptions.keys());
+    locales.append(element.keywords.keys());
+    locales.removeDuplicates();
+    locales.sort(Qt::CaseSensitive);
+    foreach (const QString& locale, locales)
     {
-        ElementType element(filepath, true);
+        QSqlQuery& query = prepareCachedQuery(
+            "INSERT INTO " % table.tablename % "_tr "
+            "(" % table.idRowName % ", locale, name, description, keywords) VALUES "
+            "(:element_id, :locale, :name, :description, :keywords)");
+        query.bindValue(":element_id",  id);
+        query.bindValue(":locale",      locale);
+        query.bindValue(":name",        element.names.value(locale));
+        query.bindValue(":description", element.descriptions.value(locale));
+        query.bindValue(":keywords",    element.keywords.value(locale));
+        execQuery(query, false);
+    }
 
-        QSqlQuery query = prepareQuery(
-            "INSERT INTO " % tablename % " "
-            "(filepath, uuid, version, parent_uuid) VALUES "
-            "(:filepath, :uuid, :version, :parent_uuid)");
-        query.bindValue(":filepath",    filepath.toRelative(mLibPath));
-        query.bindValue(":uuid",        element.getUuid().toStr());
-        query.bindValue(":version",     element.getVersion().toStr());
-        query.bindValue(":parent_uuid", element.getParentUuid().isNull() ? QVariant(QVariant::String) : element.getParentUuid().toStr());
-        int id = execQuery(query, true);
-
-        foreach (const QString& locale, element.getAllAvailableLocales())
+    foreach (const Uuid& categoryUuid, element.categories)
+    {
+        Q_ASSERT(table.hasCategories);
+        Q_ASSERT(!categoryUuid.isNull());
+        QSqlQuery& query = prepareCachedQuery(
+            "INSERT INTO " % table.tablename % "_cat "
+            "(" % table.idRowName % ", category_uuid) VALUES "
+            "(:element_id, :category_uuid)");
+        query.bindValue(":element_id",  id);
+        query.bindValue(":category_uuid", categoryUuid.toStr());
+        execQuery(query, false);
+    }
+
+    foreach (const SymbolVariantMetadata& symbVar, element.symbolVariants)
+    {
+        Q_ASSERT(table.type == Components);
+        QSqlQuery& query = prepareCachedQuery(
+            "INSERT INTO components_symbvars "
+            "(component_id, uuid, norm, is_default, item_count) VALUES "
+            "(:component_id, :uuid, :norm, :is_default, :item_count)");
+        query.bindValue(":component_id",    id);
+        query.bindValue(":uuid",            symbVar.uuid.toStr());
+        query.bindValue(":norm",            symbVar.norm);
+        query.bindValue(":is_default",      symbVar.isDefault);
+        query.bindValue(":item_count",      symbVar.itemCount);
+        int symbVarId = execQuery(query, true);
+
+        QStringList locales = symbVar.names.keys() + symbVar.descriptions.keys();
+        locales.removeDuplicates();
+        foreach (const QString& locale, locales)
         {
-            QSqlQuery query = prepareQuery(
-                "INSERT INTO " % tablename % "_tr "
-                "(" % id_rowname % ", locale, name, description, keywords) VALUES "
-                "(:element_id, :locale, :name, :description, :keywords)");
-            query.bindValue(":element_id",  id);
+            QSqlQuery& query = prepareCachedQuery(
+                "INSERT INTO components_symbvars_tr "
+                "(symbvar_id, locale, name, description) VALUES "
+                "(:symbvar_id, :locale, :name, :description)");
+            query.bindValue(":symbvar_id",  symbVarId);
             query.bindValue(":locale",      locale);
-            query.bindValue(":name",        element.getNames().value(locale));
-            query.bindValue(":description", element.getDescriptions().value(locale));
-            query.bindValue(":keywords",    element.getKeywords().value(locale));
+            query.bindValue(":name",        symbVar.names.value(locale));
+            query.bindValue(":description", symbVar.descriptions.value(locale));
             execQuery(query, false);
         }
-        count++;
     }
-    return count;
 }
 
-template <typename ElementType>
-int Library::addElementsToDb(const QList<FilePath>& dirs, const QString& tablename,
-                             const QString& id_rowname) throw (Exception)
+void Library::removeElementFromDb(const ElementTable& table, int id) throw (Exception)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs)
-    {
-        ElementType element(filepath, true);
+    if (table.type == Components) {
+        QSqlQuery& trQuery = prepareCachedQuery(
+            "DELETE FROM components_symbvars_tr WHERE symbvar_id IN "
+            "(SELECT id FROM components_symbvars WHERE component_id = :id)");
+        trQuery.bindValue(":id", id);
+        execQuery(trQuery, false);
+        QSqlQuery& query = prepareCachedQuery(
+            "DELETE FROM components_symbvars WHERE component_id = :id");
+        query.bindValue(":id", id);
+        execQuery(query, false);
+    }
 
-        QSqlQuery query = prepareQuery(
-            "INSERT INTO " % tablename % " "
-            "(filepath, uuid, version) VALUES "
-            "(:filepath, :uuid, :version)");
-        query.bindValue(":filepath",    filepath.toRelative(mLibPath));
-        query.bindValue(":uuid",        element.getUuid().toStr());
-        query.bindValue(":version",     element.getVersion().toStr());
-        int id = execQuery(query, true);
-
-        foreach (const QString& locale, element.getAllAvailableLocales())
-        {
-            QSqlQuery query = prepareQuery(
-                "INSERT INTO " % tablename % "_tr "
-                "(" % id_rowname % ", locale, name, description, keywords) VALUES "
-                "(:element_id, :locale, :name, :description, :keywords)");
-            query.bindValue(":element_id",  id);
-            query.bindValue(":locale",      locale);
-            query.bindValue(":name",        element.getNames().value(locale));
-            query.bindValue(":description", element.getDescriptions().value(locale));
-            query.bindValue(":keywords",    element.getKeywords().value(locale));
-            execQuery(query, false);
-        }
+    QStringList tablenames;
+    tablenames << table.tablename % "_tr";
+    if (table.hasCategories) tablenames << table.tablename % "_cat";
+    foreach (const QString& tablename, tablenames) {
+        QSqlQuery& query = prepareCachedQuery(
+            "DELETE FROM " % tablename % " WHERE " % table.idRowName % " = :id");
+        query.bindValue(":id", id);
+        execQuery(query, false);
+    }
+    QSqlQuery& query = prepareCachedQuery("DELETE FROM " % table.tablename % " WHERE id = :id");
+    query.bindValue(":id", id);
+    execQuery(query, false);
+}
 
-        foreach (const Uuid& categoryUuid, element.getCategories())
-        {
-            Q_ASSERT(!categoryUuid.isNull());
-            QSqlQuery query = prepareQuery(
-                "INSERT INTO " % tablename % "_cat "
-                "(" % id_rowname % ", category_uuid) VALUES "
-                "(:element_id, :category_uuid)");
-            query.bindValue(":element_id",  id);
-            query.bindValue(":category_uuid", categoryUuid.toStr());
-            execQuery(query, false);
-        }
+QHash<QString, QPair<int, QString>> Library::getFingerprintsFromDb(const ElementTable& table) const throw (Exception)
+{
+    QSqlQuery query = prepareQuery(
+        "SELECT id, filepath, fingerprint FROM " % table.tablename);
+    execQuery(query, false);
 
-        count++;
+    QHash<QString, QPair<int, QString>> elements;
+    while (query.next())
+    {
+        elements.insert(query.value(1).toString(),
+                        qMakePair(query.value(0).toInt(), query.value(2).toString()));
     }
-    return count;
+    return elements;
 }
 
-int Library::addDevicesToDb(const QList<FilePath>& dirs, const QString& tablename,
-                            const QString& id_rowname) throw (Exception)
+int Library::getDatabaseSchemaVersion() const noexcept
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs)
+    try
     {
-        Device element(filepath, true);
-
         QSqlQuery query = prepareQuery(
-            "INSERT INTO " % tablename % " "
-            "(filepath, uuid, version, component_uuid, package_uuid) VALUES "
-            "(:filepath, :uuid, :version, :component_uuid, :package_uuid)");
-        query.bindValue(":filepath",        filepath.toRelative(mLibPath));
-        query.bindValue(":uuid",            element.getUuid().toStr());
-        query.bindValue(":version",         element.getVersion().toStr());
-        query.bindValue(":component_uuid",  element.getComponentUuid().toStr());
-        query.bindValue(":package_uuid",    element.getPackageUuid().toStr());
-        int id = execQuery(query, true);
-
-        foreach (const QString& locale, element.getAllAvailableLocales())
-        {
-            QSqlQuery query = prepareQuery(
-                "INSERT INTO " % tablename % "_tr "
-                "(" % id_rowname % ", locale, name, description, keywords) VALUES "
-                "(:element_id, :locale, :name, :description, :keywords)");
-            query.bindValue(":element_id",  id);
-            query.bindValue(":locale",      locale);
-            query.bindValue(":name",        element.getNames().value(locale));
-            query.bindValue(":description", element.getDescriptions().value(locale));
-            query.bindValue(":keywords",    element.getKeywords().value(locale));
-            execQuery(query, false);
-        }
-
-        foreach (const Uuid& categoryUuid, element.getCategories())
-        {
-            Q_ASSERT(!categoryUuid.isNull());
-            QSqlQuery query = prepareQuery(
-                "INSERT INTO " % tablename % "_cat "
-                "(" % id_rowname % ", category_uuid) VALUES "
-                "(:element_id, :category_uuid)");
-            query.bindValue(":element_id",  id);
-            query.bindValue(":category_uuid", categoryUuid.toStr());
-            execQuery(query, false);
+            "SELECT value_int FROM internal WHERE key = 'schema_version'");
+        execQuery(query, false);
+        if (query.first()) {
+            return query.value(0).toInt();
         }
-
-        count++;
     }
-    return count;
+    catch (const Exception&)
+    {
+        // the table does not exist, i.e. the database was never created
+    }
+    return -1;
 }
 
 QMultiMap<Version, FilePath> Library::getElementFilePathsFromDb(const QString& tablename,
@@ -451,6 +694,61 @@ QSet<Uuid> Library::getCategoryChilds(const QString& tablename, const Uuid& cate
     return elements;
 }
 
+QList<Library::CategoryMetadata> Library::getCategoryChildsMetadata(const QString& tablename,
+    const Uuid& categoryUuid) const throw (Exception)
+{
+    QString condition = "parent_uuid " %
+        (categoryUuid.isNull() ? QString("IS NULL") : "= '" % categoryUuid.toStr() % "'");
+
+    QList<CategoryMetadata> list;
+    QList<int> ids; // the database IDs of the categories in list
+    QHash<Uuid, int> uuidIndexes; // only keep the latest version of each category
+    QSqlQuery query = prepareQuery(
+        "SELECT id, uuid, version, filepath, "
+        "(SELECT COUNT(*) FROM " % tablename % " AS childs "
+        "WHERE childs.parent_uuid = " % tablename % ".uuid) "
+        "FROM " % tablename % " WHERE " % condition);
+    execQuery(query, false);
+    while (query.next())
+    {
+        CategoryMetadata cat;
+        cat.uuid = Uuid(query.value(1).toString());
+        cat.version = Version(query.value(2).toString());
+        cat.filepath = FilePath::fromRelative(mLibPath, query.value(3).toString());
+        cat.childCount = query.value(4).toInt();
+        if (cat.uuid.isNull() || (!cat.version.isValid()) || (!cat.filepath.isValid())) {
+            qWarning() << "Invalid category in library:" << tablename << "::" << query.value(3);
+            continue;
+        }
+        if (!uuidIndexes.contains(cat.uuid)) {
+            uuidIndexes.insert(cat.uuid, list.count());
+            list.append(cat);
+            ids.append(query.value(0).toInt());
+        } else if (cat.version > list.at(uuidIndexes.value(cat.uuid)).version) {
+            list[uuidIndexes.value(cat.uuid)] = cat;
+            ids[uuidIndexes.value(cat.uuid)] = query.value(0).toInt();
+        }
+    }
+    QHash<int, int> indexes; // key: category id, value: index in list
+    for (int i = 0; i < ids.count(); ++i) {
+        indexes.insert(ids.at(i), i);
+    }
+
+    QSqlQuery trQuery = prepareQuery(
+        "SELECT cat_id, locale, name, description FROM " % tablename % "_tr "
+        "WHERE cat_id IN (SELECT id FROM " % tablename % " WHERE " % condition % ")");
+    execQuery(trQuery, false);
+    while (trQuery.next())
+    {
+        if (!indexes.contains(trQuery.value(0).toInt())) continue; // older version
+        CategoryMetadata& cat = list[indexes.value(trQuery.value(0).toInt())];
+        QString locale = trQuery.value(1).toString();
+        if (!trQuery.value(2).isNull()) cat.names.insert(locale, trQuery.value(2).toString());
+        if (!trQuery.value(3).isNull()) cat.descriptions.insert(locale, trQuery.value(3).toString());
+    }
+    return list;
+}
+
 QSet<Uuid> Library::getElementsByCategory(const QString& tablename,
     const QString& idrowname, const Uuid& categoryUuid) const throw (Exception)
 {
@@ -479,6 +777,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     QStringList queries;
 
     // internal
+    queries << QString( "DROP TABLE IF EXISTS search_index");
     queries << QString( "DROP TABLE IF EXISTS internal");
     queries << QString( "CREATE TABLE internal ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
@@ -513,6 +812,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE component_categories ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
                         "`parent_uuid` TEXT"
@@ -533,6 +833,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE package_categories ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
                         "`parent_uuid` TEXT"
@@ -554,6 +855,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE symbols ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL"
                         ")");
@@ -580,6 +882,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE spice_models ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL"
                         ")");
@@ -606,6 +909,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE packages ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL "
                         ")");
@@ -626,12 +930,15 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
                         ")");
 
     // components
+    queries << QString( "DROP TABLE IF EXISTS components_symbvars_tr");
+    queries << QString( "DROP TABLE IF EXISTS components_symbvars");
     queries << QString( "DROP TABLE IF EXISTS components_tr");
     queries << QString( "DROP TABLE IF EXISTS components_cat");
     queries << QString( "DROP TABLE IF EXISTS components");
     queries << QString( "CREATE TABLE components ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL"
                         ")");
@@ -650,6 +957,23 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
                         "`category_uuid` TEXT NOT NULL, "
                         "UNIQUE(component_id, category_uuid)"
                         ")");
+    queries << QString( "CREATE TABLE components_symbvars ("
+                        "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
+                        "`component_id` INTEGER REFERENCES components(id) NOT NULL, "
+                        "`uuid` TEXT NOT NULL, "
+                        "`norm` TEXT, "
+                        "`is_default` INTEGER NOT NULL, "
+                        "`item_count` INTEGER NOT NULL, "
+                        "UNIQUE(component_id, uuid)"
+                        ")");
+    queries << QString( "CREATE TABLE components_symbvars_tr ("
+                        "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
+                        "`symbvar_id` INTEGER REFERENCES components_symbvars(id) NOT NULL, "
+                        "`locale` TEXT NOT NULL, "
+                        "`name` TEXT, "
+                        "`description` TEXT, "
+                        "UNIQUE(symbvar_id, locale)"
+                        ")");
 
     // devices
     queries << QString( "DROP TABLE IF EXISTS devices_tr");
@@ -658,6 +982,7 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
     queries << QString( "CREATE TABLE devices ("
                         "`id` INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`fingerprint` TEXT NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
                         "`component_uuid` TEXT NOT NULL, "
@@ -679,12 +1004,74 @@ void Library::clearDatabaseAndCreateTables() throw (Exception)
                         "UNIQUE(device_id, category_uuid)"
                         ")");
 
+    // indexes (note: UNIQUE constraints are indexed anyway)
+    foreach (const ElementTable& table, getElementTables()) {
+        queries << QString( "CREATE INDEX %1_uuid_index ON %1 (uuid)").arg(table.tablename);
+        if (table.hasCategories) {
+            queries << QString( "CREATE INDEX %1_cat_category_uuid_index "
+                                "ON %1_cat (category_uuid)").arg(table.tablename);
+        }
+    }
+    queries << QString( "CREATE INDEX component_categories_parent_uuid_index "
+                        "ON component_categories (parent_uuid)");
+    queries << QString( "CREATE INDEX package_categories_parent_uuid_index "
+                        "ON package_categories (parent_uuid)");
+    queries << QString( "CREATE INDEX devices_component_uuid_index "
+                        "ON devices (component_uuid)");
+
+    // schema version
+    queries << QString( "INSERT INTO internal (key, value_int) "
+                        "VALUES ('schema_version', %1)").arg(sDatabaseSchemaVersion);
+
     // execute queries
     foreach (const QString& string, queries)
     {
         QSqlQuery query = prepareQuery(string);
         execQuery(query, false);
     }
+
+    // full-text search index over all translation tables, kept up to date by triggers
+    // (the rowid is built from the translation row id and the element type to allow
+    // fast deletions)
+    QStringList ftsQueries;
+    ftsQueries << QString(  "CREATE VIRTUAL TABLE search_index USING fts5("
+                            "element_type UNINDEXED, "
+                            "element_id UNINDEXED, "
+                            "name, "
+                            "description, "
+                            "keywords, "
+                            "prefix = '2 3', "
+                            "tokenize = 'unicode61 remove_diacritics 1'"
+                            ")");
+    foreach (const ElementTable& table, getElementTables()) {
+        ftsQueries << QString(  "CREATE TRIGGER %1_tr_search_insert AFTER INSERT ON %1_tr "
+                                "BEGIN "
+                                "INSERT INTO search_index "
+                                "(rowid, element_type, element_id, name, description, keywords) "
+                                "VALUES (new.id * 128 + %3, %3, new.%2, new.name, "
+                                "new.description, new.keywords); "
+                                "END")
+                                .arg(table.tablename, table.idRowName).arg(table.type);
+        ftsQueries << QString(  "CREATE TRIGGER %1_tr_search_delete AFTER DELETE ON %1_tr "
+                                "BEGIN "
+                                "DELETE FROM search_index WHERE rowid = old.id * 128 + %2; "
+                                "END")
+                                .arg(table.tablename).arg(table.type);
+    }
+    try
+    {
+        foreach (const QString& string, ftsQueries)
+        {
+            QSqlQuery query = prepareQuery(string);
+            execQuery(query, false);
+        }
+    }
+    catch (const Exception& e)
+    {
+        // the SQLite library was probably compiled without the FTS5 extension
+        qWarning() << "Could not create the library full-text search index:"
+                   << e.getDebugMsg();
+    }
 }
 
 QMultiMap<QString, FilePath> Library::getAllElementDirectories() throw (Exception)
@@ -712,6 +1099,15 @@ QSqlQuery Library::prepareQuery(const QString& query) const throw (Exception)
     return q;
 }
 
+QSqlQuery& Library::prepareCachedQuery(const QString& query) throw (Exception)
+{
+    auto it = mCachedQueries.find(query);
+    if (it == mCachedQueries.end()) {
+        it = mCachedQueries.insert(query, prepareQuery(query));
+    }
+    return it.value();
+}
+
 int Library::execQuery(QSqlQuery& query, bool checkId) const throw (Exception)
 {
     if (!query.exec())
@@ -731,6 +1127,214 @@ int Library::execQuery(QSqlQuery& query, bool checkId) const throw (Exception)
     return id;
 }
 
+QList<Library::ComponentMetadata> Library::getComponentsMetadata(const QString& condition) const throw (Exception)
+{
+    // Note: All translations and symbol variants are fetched with a single query each,
+    // so the count of queries does not depend on the count of components.
+    QString components = "SELECT id FROM components WHERE " % condition;
+    QString symbVars = "SELECT id FROM components_symbvars WHERE component_id IN (" % components % ")";
+
+    QList<ComponentMetadata> list;
+    QHash<int, int> cmpIndexes; // key: component id, value: index in list
+    QSqlQuery cmpQuery = prepareQuery(
+        "SELECT id, uuid, version, filepath FROM components WHERE " % condition);
+    execQuery(cmpQuery, false);
+    while (cmpQuery.next())
+    {
+        ComponentMetadata cmp;
+        cmp.uuid = Uuid(cmpQuery.value(1).toString());
+        cmp.version = Version(cmpQuery.value(2).toString());
+        cmp.filepath = FilePath::fromRelative(mLibPath, cmpQuery.value(3).toString());
+        if (cmp.uuid.isNull() || (!cmp.version.isValid()) || (!cmp.filepath.isValid())) {
+            qWarning() << "Invalid element in library: components::" << cmpQuery.value(3);
+            continue;
+        }
+        cmpIndexes.insert(cmpQuery.value(0).toInt(), list.count());
+        list.append(cmp);
+    }
+
+    QSqlQuery trQuery = prepareQuery(
+        "SELECT component_id, locale, name, description, keywords FROM components_tr "
+        "WHERE component_id IN (" % components % ")");
+    execQuery(trQuery, false);
+    while (trQuery.next())
+    {
+        if (!cmpIndexes.contains(trQuery.value(0).toInt())) continue;
+        ComponentMetadata& cmp = list[cmpIndexes.value(trQuery.value(0).toInt())];
+        QString locale = trQuery.value(1).toString();
+        if (!trQuery.value(2).isNull()) cmp.names.insert(locale, trQuery.value(2).toString());
+        if (!trQuery.value(3).isNull()) cmp.descriptions.insert(locale, trQuery.value(3).toString());
+        if (!trQuery.value(4).isNull()) cmp.keywords.insert(locale, trQuery.value(4).toString());
+    }
+
+    QHash<int, QPair<int, int>> symbVarIndexes; // value: component index, symbvar index
+    QSqlQuery symbVarQuery = prepareQuery(
+        "SELECT id, component_id, uuid, norm, is_default, item_count FROM components_symbvars "
+        "WHERE component_id IN (" % components % ") ORDER BY id");
+    execQuery(symbVarQuery, false);
+    while (symbVarQuery.next())
+    {
+        if (!cmpIndexes.contains(symbVarQuery.value(1).toInt())) continue;
+        int cmpIndex = cmpIndexes.value(symbVarQuery.value(1).toInt());
+        SymbolVariantMetadata symbVar;
+        symbVar.uuid = Uuid(symbVarQuery.value(2).toString());
+        symbVar.norm = symbVarQuery.value(3).toString();
+        symbVar.isDefault = symbVarQuery.value(4).toBool();
+        symbVar.itemCount = symbVarQuery.value(5).toInt();
+        symbVarIndexes.insert(symbVarQuery.value(0).toInt(),
+                              qMakePair(cmpIndex, list[cmpIndex].symbolVariants.count()));
+        list[cmpIndex].symbolVariants.append(symbVar);
+    }
+
+    QSqlQuery symbVarTrQuery = prepareQuery(
+        "SELECT symbvar_id, locale, name, description FROM components_symbvars_tr "
+        "WHERE symbvar_id IN (" % symbVars % ")");
+    execQuery(symbVarTrQuery, false);
+    while (symbVarTrQuery.next())
+    {
+        if (!symbVarIndexes.contains(symbVarTrQuery.value(0).toInt())) continue;
+        QPair<int, int> index = symbVarIndexes.value(symbVarTrQuery.value(0).toInt());
+        SymbolVariantMetadata& symbVar = list[index.first].symbolVariants[index.second];
+        QString locale = symbVarTrQuery.value(1).toString();
+        if (!symbVarTrQuery.value(2).isNull()) symbVar.names.insert(locale, symbVarTrQuery.value(2).toString());
+        if (!symbVarTrQuery.value(3).isNull()) symbVar.descriptions.insert(locale, symbVarTrQuery.value(3).toString());
+    }
+
+    return list;
+}
+
+bool Library::isFullTextSearchAvailable() const noexcept
+{
+    try
+    {
+        QSqlQuery query = prepareQuery(
+            "SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'search_index'");
+        execQuery(query, false);
+        return query.first();
+    }
+    catch (const Exception&)
+    {
+        return false;
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QList<Library::ElementTable> Library::getElementTables() noexcept
+{
+    QList<ElementTable> tables;
+    tables.append(ElementTable{ComponentCategories, "cmpcat", "component_categories", "cat_id",       false});
+    tables.append(ElementTable{PackageCategories,   "pkgcat", "package_categories",   "cat_id",       false});
+    tables.append(ElementTable{Symbols,             "sym",    "symbols",              "symbol_id",    true});
+    tables.append(ElementTable{SpiceModels,         "spcmdl", "spice_models",         "model_id",     true});
+    tables.append(ElementTable{Packages,            "pkg",    "packages",             "package_id",   true});
+    tables.append(ElementTable{Components,          "cmp",    "components",           "component_id", true});
+    tables.append(ElementTable{Devices,             "dev",    "devices",              "device_id",    true});
+    return tables;
+}
+
+Library::ElementMetadata Library::calcElementFingerprint(const ElementMetadata& element) noexcept
+{
+    // the fingerprint is built from the relative path, size and modification time of all
+    // files in the element directory and all its subdirectories, so no file needs to be
+    // read to detect modifications
+    QDir dir(element.filepath.toStr());
+    QStringList entries;
+    QDirIterator it(dir.path(), QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo& info = it.fileInfo();
+        entries.append(QString("%1:%2:%3").arg(dir.relativeFilePath(info.filePath()))
+                       .arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch()));
+    }
+    entries.sort(); // the iteration order is not defined
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    foreach (const QString& entry, entries) {
+        hash.addData(entry.toUtf8());
+    }
+
+    ElementMetadata result = element;
+    result.fingerprint = QString(hash.result().toHex());
+    return result;
+}
+
+Library::ElementMetadata Library::readElementMetadata(const ElementMetadata& element) noexcept
+{
+    ElementMetadata result = element;
+    try
+    {
+        const QString& suffix = element.dirSuffix;
+        if (suffix == "cmpcat") {
+            ComponentCategory cat(element.filepath, true);
+            readBaseElementMetadata(cat, result);
+            result.parentUuid = cat.getParentUuid();
+        } else if (suffix == "pkgcat") {
+            PackageCategory cat(element.filepath, true);
+            readBaseElementMetadata(cat, result);
+            result.parentUuid = cat.getParentUuid();
+        } else if (suffix == "sym") {
+            Symbol sym(element.filepath, true);
+            readBaseElementMetadata(sym, result);
+            result.categories = sym.getCategories();
+        } else if (suffix == "spcmdl") {
+            SpiceModel model(element.filepath, true);
+            readBaseElementMetadata(model, result);
+            result.categories = model.getCategories();
+        } else if (suffix == "pkg") {
+            Package pkg(element.filepath, true);
+            readBaseElementMetadata(pkg, result);
+            result.categories = pkg.getCategories();
+        } else if (suffix == "cmp") {
+            Component cmp(element.filepath, true);
+            readBaseElementMetadata(cmp, result);
+            result.categories = cmp.getCategories();
+            for (int i = 0; i < cmp.getSymbolVariantCount(); ++i) {
+                const ComponentSymbolVariant* symbVar = cmp.getSymbolVariant(i);
+                SymbolVariantMetadata symbVarMetadata;
+                symbVarMetadata.uuid = symbVar->getUuid();
+                symbVarMetadata.norm = symbVar->getNorm();
+                symbVarMetadata.isDefault = (symbVar->getUuid() == cmp.getDefaultSymbolVariantUuid());
+                symbVarMetadata.itemCount = symbVar->getItemCount();
+                symbVarMetadata.names = symbVar->getNames();
+                symbVarMetadata.descriptions = symbVar->getDescriptions();
+                result.symbolVariants.append(symbVarMetadata);
+            }
+        } else if (suffix == "dev") {
+            Device dev(element.filepath, true);
+            readBaseElementMetadata(dev, result);
+            result.categories = dev.getCategories();
+            result.componentUuid = dev.getComponentUuid();
+            result.packageUuid = dev.getPackageUuid();
+        } else {
+            throw LogicError(__FILE__, __LINE__, suffix);
+        }
+    }
+    catch (const Exception& e)
+    {
+        result.error.reset(e.clone());
+    }
+    return result;
+}
+
+template <typename ElementType>
+void Library::readBaseElementMetadata(const ElementType& libElement,
+                                      ElementMetadata& element) noexcept
+{
+    element.uuid = libElement.getUuid();
+    element.version = libElement.getVersion();
+    element.names = libElement.getNames();
+    element.descriptions = libElement.getDescriptions();
+    element.keywords = libElement.getKeywords();
+}
+
+/*****************************************************************************************
+ *  Static Attributes
+ ****************************************************************************************/
+
+const int Library::sDatabaseSchemaVersion = 3;
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtSql>
+#include <librepcbcommon/version.h>
 #include <librepcbcommon/uuid.h>
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/fileio/filepath.h>
@@ -34,8 +35,6 @@
  ****************************************************************************************/
 namespace librepcb {
 
-class Version;
-
 namespace library {
 
 class ComponentCategory;
@@ -54,12 +53,8 @@ class Device;
  * @brief The Library class
  *
  * @todo This class needs some refactoring:
- *          - rescan() is very slow
  *          - rescan() does not report its progress
  *          - rescan() blocks the whole application
- *          - rescan() does not really have exception handling
- *          - rescan() searches all XML files instead of element directories
- *              --> error if there are multiple XML files in one element directory
  *          - many other issues...
  */
 class Library final : public QObject
@@ -68,6 +63,67 @@ class Library final : public QObject
 
     public:
 
+        // Types
+
+        /// Library element types (can be combined as #ElementTypes flags)
+        enum ElementType {
+            ComponentCategories = 0x01,
+            PackageCategories   = 0x02,
+            Symbols             = 0x04,
+            SpiceModels         = 0x08,
+            Packages            = 0x10,
+            Components          = 0x20,
+            Devices             = 0x40,
+            AllElementTypes     = 0x7F
+        };
+        Q_DECLARE_FLAGS(ElementTypes, ElementType)
+
+        /// A single result returned by #search()
+        struct SearchResult {
+            ElementType type;   ///< the type of the found element
+            Uuid uuid;          ///< the UUID of the found element
+            FilePath filepath;  ///< the directory of the found element
+            QString name;       ///< the name of the element (see #search())
+        };
+
+        /// Metadata of a category, read from the cache without parsing the XML file
+        struct CategoryMetadata {
+            Uuid uuid;
+            Version version;
+            FilePath filepath;                      ///< the category directory
+            QMap<QString, QString> names;           ///< key: locale, value: name
+            QMap<QString, QString> descriptions;    ///< key: locale, value: description
+            int childCount;                         ///< count of child categories
+        };
+
+        /// Metadata of a component's symbol variant, see #ComponentMetadata
+        struct SymbolVariantMetadata {
+            Uuid uuid;
+            QString norm;
+            bool isDefault;                         ///< default symbol variant or not
+            int itemCount;                          ///< count of symbol items
+            QMap<QString, QString> names;           ///< key: locale, value: name
+            QMap<QString, QString> descriptions;    ///< key: locale, value: description
+        };
+
+        /// Metadata of a component, read from the cache without parsing the XML file
+        struct ComponentMetadata {
+            Uuid uuid;
+            Version version;
+            FilePath filepath;                      ///< the component directory
+            QMap<QString, QString> names;           ///< key: locale, value: name
+            QMap<QString, QString> descriptions;    ///< key: locale, value: description
+            QMap<QString, QString> keywords;        ///< key: locale, value: keywords
+            QList<SymbolVariantMetadata> symbolVariants;
+        };
+
+        /// Defines which library elements are parsed by #rescan()
+        enum class RescanMode {
+            Incremental,    ///< only parse added or modified elements
+            Full            ///< clear the whole database and parse all elements
+        };
+
+
         // Constructors / Destructor
 
         /**
@@ -106,18 +162,72 @@ class Library final : public QObject
                                QString* nameEn = nullptr) const throw (Exception);
         void getPackageMetadata(const FilePath& pkgDir, QString* nameEn = nullptr) const throw (Exception);
 
+        /**
+         * @brief Get the metadata of all components of a category
+         *
+         * @param category  The category UUID (NULL for components without category)
+         *
+         * @return The metadata of the latest version (in the whole library) of each
+         *         component which is listed in the category by any of its versions
+         */
+        QList<ComponentMetadata> getComponentsMetadataByCategory(const Uuid& category) const throw (Exception);
+
         // Getters: Special
         QSet<Uuid> getComponentCategoryChilds(const Uuid& parent) const throw (Exception);
         QSet<Uuid> getPackageCategoryChilds(const Uuid& parent) const throw (Exception);
+
+        /**
+         * @brief Get the metadata of all child categories of a category
+         *
+         * @param parent    The parent category UUID (NULL for root categories)
+         *
+         * @return The metadata of the latest version of each child category
+         */
+        QList<CategoryMetadata> getComponentCategoryChildsMetadata(const Uuid& parent) const throw (Exception);
+        QList<CategoryMetadata> getPackageCategoryChildsMetadata(const Uuid& parent) const throw (Exception);
         QSet<Uuid> getComponentsByCategory(const Uuid& category) const throw (Exception);
         QSet<Uuid> getDevicesOfComponent(const Uuid& component) const throw (Exception);
 
+        /**
+         * @brief Search library elements by their names, descriptions and keywords
+         *
+         * All whitespace separated terms of the query must match (as word prefixes)
+         * in any locale. If the SQLite library provides the FTS5 extension, a full-text
+         * index is used and the results are sorted by relevance, otherwise a (much
+         * slower) substring search is done.
+         *
+         * @param query         The search terms entered by the user
+         * @param types         The element types to search for
+         * @param localeOrder   The locale order used for the names of the results
+         * @param limit         The maximum count of results to return
+         *
+         * @return A list of matching elements (each directory is returned only once)
+         */
+        QList<SearchResult> search(const QString& query, ElementTypes types,
+                                   const QStringList& localeOrder,
+                                   int limit) const throw (Exception);
+
         // General Methods
 
         /**
          * @brief Rescan the whole library directory and update the SQLite database
+         *
+         * In the incremental mode, the fingerprint of each element directory (see
+         * #calcElementFingerprint()) is compared with the one stored in the database
+         * and only added or modified elements are parsed, while removed elements are
+         * deleted from the database. If the database schema is outdated, a full rescan
+         * is done anyway. The element files are parsed by a pool of worker threads,
+         * the database is only written by the calling thread (within a single
+         * transaction and with reused prepared statements).
+         *
+         * @param mode      See #RescanMode
+         *
+         * @return The count of valid library elements in the database
+         *
+         * @throw Exception If an element could not be parsed. All other elements are
+         *                  added to the database anyway.
          */
-        int rescan() throw (Exception);
+        int rescan(RescanMode mode = RescanMode::Incremental) throw (Exception);
 
 
     private:
@@ -128,31 +238,77 @@ class Library final : public QObject
         Library& operator=(const Library& rhs);
 
 
+        // Types
+
+        /// Table names of one library element type in the database
+        struct ElementTable {
+            ElementType type;   ///< the element type stored in this table
+            QString dirSuffix;  ///< suffix of the element directories (e.g. "sym")
+            QString tablename;  ///< name of the main table (e.g. "symbols")
+            QString idRowName;  ///< foreign key row name in "_tr" and "_cat" tables
+            bool hasCategories; ///< whether there is a "_cat" table or not
+        };
+
+        /// Metadata of an element directory, filled by the rescan worker threads
+        struct ElementMetadata {
+            QString dirSuffix;
+            FilePath filepath;
+            QString fingerprint;
+            Uuid uuid;
+            Version version;
+            Uuid parentUuid;        ///< only used for categories
+            Uuid componentUuid;     ///< only used for devices
+            Uuid packageUuid;       ///< only used for devices
+            QList<Uuid> categories;
+            QList<SymbolVariantMetadata> symbolVariants; ///< only used for components
+            QMap<QString, QString> names;
+            QMap<QString, QString> descriptions;
+            QMap<QString, QString> keywords;
+            QSharedPointer<Exception> error; ///< set if the element could not be parsed
+        };
+
+
         // Private Methods
-        template <typename ElementType>
-        int addCategoriesToDb(const QList<FilePath>& dirs, const QString& tablename,
-                              const QString& id_rowname) throw (Exception);
-        template <typename ElementType>
-        int addElementsToDb(const QList<FilePath>& dirs, const QString& tablename,
-                            const QString& id_rowname) throw (Exception);
-        int addDevicesToDb(const QList<FilePath>& dirs, const QString& tablename,
-                           const QString& id_rowname) throw (Exception);
+        void addElementToDb(const ElementTable& table,
+                            const ElementMetadata& element) throw (Exception);
+        void removeElementFromDb(const ElementTable& table, int id) throw (Exception);
+        QHash<QString, QPair<int, QString>> getFingerprintsFromDb(const ElementTable& table) const throw (Exception);
+        int getDatabaseSchemaVersion() const noexcept;
+        QList<ComponentMetadata> getComponentsMetadata(const QString& condition) const throw (Exception);
+        bool isFullTextSearchAvailable() const noexcept;
         QMultiMap<Version, FilePath> getElementFilePathsFromDb(const QString& tablename,
                                                                const Uuid& uuid) const noexcept;
         FilePath getLatestVersionFilePath(const QMultiMap<Version, FilePath>& list) const noexcept;
         QSet<Uuid> getCategoryChilds(const QString& tablename, const Uuid& categoryUuid) const throw (Exception);
+        QList<CategoryMetadata> getCategoryChildsMetadata(const QString& tablename,
+                                                          const Uuid& categoryUuid) const throw (Exception);
         QSet<Uuid> getElementsByCategory(const QString& tablename, const QString& idrowname,
                                           const Uuid& categoryUuid) const throw (Exception);
         void clearDatabaseAndCreateTables() throw (Exception);
         QMultiMap<QString, FilePath> getAllElementDirectories() throw (Exception);
         QSqlQuery prepareQuery(const QString& query) const throw (Exception);
+        QSqlQuery& prepareCachedQuery(const QString& query) throw (Exception);
         int execQuery(QSqlQuery& query, bool checkId) const throw (Exception);
 
 
+        // Static Methods
+        static QList<ElementTable> getElementTables() noexcept;
+        static ElementMetadata calcElementFingerprint(const ElementMetadata& element) noexcept;
+        static ElementMetadata readElementMetadata(const ElementMetadata& element) noexcept;
+        template <typename ElementType>
+        static void readBaseElementMetadata(const ElementType& libElement,
+                                            ElementMetadata& element) noexcept;
+
+
+        // Constants
+        static const int sDatabaseSchemaVersion; ///< must be incremented on schema changes
+
+
         // Attributes
         FilePath mLibPath; ///< a FilePath object which represents the library directory
         FilePath mLibFilePath; ///< a #FilePath object which represents the library_cache.sqlite file
         QSqlDatabase mLibDatabase; ///< the SQLite database of the file #mLibFilePath
+        QHash<QString, QSqlQuery> mCachedQueries; ///< see #prepareCachedQuery()
 };
 
 /*****************************************************************************************
@@ -162,4 +318,6 @@ class Library final : public QObject
 } // namespace library
 } // namespace librepcb
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(librepcb::library::Library::ElementTypes)
+
 #endif // LIBREPCB_LIBRARY_LIBRARY_H
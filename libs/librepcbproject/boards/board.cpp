@@ -35,6 +35,7 @@
 #include <librepcbcommon/gridproperties.h>
 #include "../circuit/circuit.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../circuit/componentinstance.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
@@ -44,7 +45,13 @@
 #include "items/bi_netline.h"
 #include <librepcblibrary/cmp/component.h>
 #include "items/bi_polygon.h"
+#include "graphicsitems/bgi_base.h"
 #include "boardlayerstack.h"
+#include "boarddesignrulecheck.h"
+#include "graphicsitems/bgi_airwires.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentsignalinstance.h"
+#include <librepcbcommon/airwiresbuilder.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -95,6 +102,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             BI_Via* copy = new BI_Via(*this, *via);
             Q_ASSERT(!getViaByUuid(copy->getUuid()));
             mVias.append(copy);
+            mViasByUuid.insert(copy->getUuid(), copy);
             copiedVias.insert(via, copy);
         }
 
@@ -113,6 +121,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             BI_NetPoint* copy = new BI_NetPoint(*this, *netpoint, pad, via);
             Q_ASSERT(!getNetPointByUuid(copy->getUuid()));
             mNetPoints.append(copy);
+            mNetPointsByUuid.insert(copy->getUuid(), copy);
             copiedNetPoints.insert(netpoint, copy);
         }
 
@@ -124,6 +133,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             BI_NetLine* copy = new BI_NetLine(*this, *netline, *start, *end);
             Q_ASSERT(!getNetLineByUuid(copy->getUuid()));
             mNetLines.append(copy);
+            mNetLinesByUuid.insert(copy->getUuid(), copy);
         }
 
         // copy polygons
@@ -132,24 +142,28 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             mPolygons.append(copy);
         }
 
-        updateErcMessages();
+        scheduleErcMessagesUpdate();
         updateIcon();
 
         // emit the "attributesChanged" signal when the project has emited it
         connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
 
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::scheduleErcMessagesUpdate);
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::scheduleErcMessagesUpdate);
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        qDeleteAll(mErcMsgListDesignRuleViolations);    mErcMsgListDesignRuleViolations.clear();
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
+        mNetLinesByUuid.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
+        mNetPointsByUuid.clear();
         qDeleteAll(mNetPoints);         mNetPoints.clear();
+        mViasByUuid.clear();
         qDeleteAll(mVias);              mVias.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
         mDesignRules.reset();
@@ -162,7 +176,8 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
 }
 
 Board::Board(Project& project, const FilePath& filepath, bool restore,
-             bool readOnly, bool create, const QString& newName) throw (Exception) :
+             bool readOnly, bool create, const QString& newName,
+             const QSharedPointer<XmlDomDocument>& parsedDoc) throw (Exception) :
     QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false)
 {
     try
@@ -190,7 +205,8 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
         else
         {
             mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
-            QSharedPointer<XmlDomDocument> doc = mXmlFile->parseFileAndBuildDomTree(true);
+            QSharedPointer<XmlDomDocument> doc = parsedDoc;
+            if (!doc) doc = mXmlFile->parseFileAndBuildDomTree(true);
             XmlDomElement& root = doc->getRoot();
 
             // the board seems to be ready to open, so we will create all needed objects
@@ -231,6 +247,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                         .arg(via->getUuid().toStr()));
                 }
                 mVias.append(via);
+                mViasByUuid.insert(via->getUuid(), via);
             }
 
             // Load all netpoints
@@ -244,6 +261,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                         .arg(netpoint->getUuid().toStr()));
                 }
                 mNetPoints.append(netpoint);
+                mNetPointsByUuid.insert(netpoint->getUuid(), netpoint);
             }
 
             // Load all netlines
@@ -257,6 +275,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                         .arg(netline->getUuid().toStr()));
                 }
                 mNetLines.append(netline);
+                mNetLinesByUuid.insert(netline->getUuid(), netline);
             }
 
             // Load all polygons
@@ -268,24 +287,28 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             }
         }
 
-        updateErcMessages();
+        scheduleErcMessagesUpdate();
         updateIcon();
 
         // emit the "attributesChanged" signal when the project has emited it
         connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
 
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::scheduleErcMessagesUpdate);
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::scheduleErcMessagesUpdate);
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        qDeleteAll(mErcMsgListDesignRuleViolations);    mErcMsgListDesignRuleViolations.clear();
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
+        mNetLinesByUuid.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
+        mNetPointsByUuid.clear();
         qDeleteAll(mNetPoints);         mNetPoints.clear();
+        mViasByUuid.clear();
         qDeleteAll(mVias);              mVias.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
         mDesignRules.reset();
@@ -301,12 +324,17 @@ Board::~Board() noexcept
 {
     Q_ASSERT(!mIsAddedToProject);
 
+    qDeleteAll(mErcMsgListDesignRuleViolations);    mErcMsgListDesignRuleViolations.clear();
     qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
+    qDeleteAll(mAirWires);          mAirWires.clear();
 
     // delete all items
     qDeleteAll(mPolygons);          mPolygons.clear();
+    mNetLinesByUuid.clear();
     qDeleteAll(mNetLines);          mNetLines.clear();
+    mNetPointsByUuid.clear();
     qDeleteAll(mNetPoints);         mNetPoints.clear();
+    mViasByUuid.clear();
     qDeleteAll(mVias);              mVias.clear();
     qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
 
@@ -435,48 +463,63 @@ QList<BI_Base*> Board::getSelectedItems(bool vias,
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 {
     QPointF scenePosPx = pos.toPxQPointF();
+    QList<BI_Via*> vias;
+    QList<BI_NetPoint*> netpoints;
+    QList<BI_NetLine*> netlines;
+    QList<BI_Footprint*> footprints;
+    QList<BI_FootprintPad*> pads;
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        switch (item->getType()) {
+            case BI_Base::Type_t::Via:          vias.append(static_cast<BI_Via*>(item)); break;
+            case BI_Base::Type_t::NetPoint:     netpoints.append(static_cast<BI_NetPoint*>(item)); break;
+            case BI_Base::Type_t::NetLine:      netlines.append(static_cast<BI_NetLine*>(item)); break;
+            case BI_Base::Type_t::Footprint:    footprints.append(static_cast<BI_Footprint*>(item)); break;
+            case BI_Base::Type_t::FootprintPad: pads.append(static_cast<BI_FootprintPad*>(item)); break;
+            default: break;
+        }
+    }
+
     QList<BI_Base*> list;   // Note: The order of adding the items is very important (the
                             // top most item must appear as the first item in the list)!
     // vias
-    foreach (BI_Via* via, mVias)
+    foreach (BI_Via* via, vias)
     {
         if (via->isSelectable() && via->getGrabAreaScenePx().contains(scenePosPx)) {
             list.append(via);
         }
     }
     // netpoints
-    foreach (BI_NetPoint* netpoint, mNetPoints)
+    foreach (BI_NetPoint* netpoint, netpoints)
     {
         if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
             list.append(netpoint);
         }
     }
     // netlines
-    foreach (BI_NetLine* netline, mNetLines)
+    foreach (BI_NetLine* netline, netlines)
     {
         if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(scenePosPx)) {
             list.append(netline);
         }
     }
     // footprints & pads
-    foreach (BI_Device* device, mDeviceInstances)
+    foreach (BI_Footprint* footprint, footprints)
     {
-        BI_Footprint& footprint = device->getFootprint();
-        if (footprint.isSelectable() && footprint.getGrabAreaScenePx().contains(scenePosPx)) {
-            if (footprint.getIsMirrored()) {
-                list.append(&footprint);
+        if (footprint->isSelectable() && footprint->getGrabAreaScenePx().contains(scenePosPx)) {
+            if (footprint->getIsMirrored()) {
+                list.append(footprint);
             } else {
-                list.prepend(&footprint);
+                list.prepend(footprint);
             }
         }
-        foreach (BI_FootprintPad* pad, footprint.getPads())
-        {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx)) {
-                if (pad->getIsMirrored()) {
-                    list.append(pad);
-                } else {
-                    list.insert(1, pad);
-                }
+    }
+    foreach (BI_FootprintPad* pad, pads)
+    {
+        if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx)) {
+            if (pad->getIsMirrored()) {
+                list.append(pad);
+            } else {
+                list.insert(1, pad);
             }
         }
     }
@@ -486,8 +529,9 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 QList<BI_Via*> Board::getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept
 {
     QList<BI_Via*> list;
-    foreach (BI_Via* via, mVias)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos, BI_Base::Type_t::Via))
     {
+        BI_Via* via = static_cast<BI_Via*>(item);
         if (via->isSelectable() && via->getGrabAreaScenePx().contains(pos.toPxQPointF())
             && ((!netsignal) || (via->getNetSignal() == netsignal)))
         {
@@ -501,8 +545,9 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(const Point& pos, const BoardL
                                                   const NetSignal* netsignal) const noexcept
 {
     QList<BI_NetPoint*> list;
-    foreach (BI_NetPoint* netpoint, mNetPoints)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos, BI_Base::Type_t::NetPoint))
     {
+        BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
         if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF())
             && ((!layer) || (&netpoint->getLayer() == layer))
             && ((!netsignal) || (&netpoint->getNetSignal() == netsignal)))
@@ -517,8 +562,9 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(const Point& pos, const BoardLay
                                                 const NetSignal* netsignal) const noexcept
 {
     QList<BI_NetLine*> list;
-    foreach (BI_NetLine* netline, mNetLines)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos, BI_Base::Type_t::NetLine))
     {
+        BI_NetLine* netline = static_cast<BI_NetLine*>(item);
         if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(pos.toPxQPointF())
             && ((!layer) || (&netline->getLayer() == layer))
             && ((!netsignal) || (&netline->getNetSignal() == netsignal)))
@@ -533,16 +579,14 @@ QList<BI_FootprintPad*> Board::getPadsAtScenePos(const Point& pos, const BoardLa
                                                  const NetSignal* netsignal) const noexcept
 {
     QList<BI_FootprintPad*> list;
-    foreach (BI_Device* device, mDeviceInstances)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos, BI_Base::Type_t::FootprintPad))
     {
-        foreach (BI_FootprintPad* pad, device->getFootprint().getPads())
+        BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+        if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(pos.toPxQPointF())
+            && ((!layer) || (pad->isOnLayer(layer->getId())))
+            && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
         {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(pos.toPxQPointF())
-                && ((!layer) || (pad->isOnLayer(layer->getId())))
-                && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
-            {
-                list.append(pad);
-            }
+            list.append(pad);
         }
     }
     return list;
@@ -596,7 +640,7 @@ void Board::addDeviceInstance(BI_Device& instance) throw (Exception)
     // add to board
     instance.addToBoard(*mGraphicsScene); // can throw
     mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit deviceAdded(instance);
 }
 
@@ -608,7 +652,7 @@ void Board::removeDeviceInstance(BI_Device& instance) throw (Exception)
     // remove from board
     instance.removeFromBoard(*mGraphicsScene); // can throw
     mDeviceInstances.remove(instance.getComponentInstanceUuid());
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit deviceRemoved(instance);
 }
 
@@ -618,16 +662,12 @@ void Board::removeDeviceInstance(BI_Device& instance) throw (Exception)
 
 BI_Via* Board::getViaByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (BI_Via* via, mVias) {
-        if (via->getUuid() == uuid)
-            return via;
-    }
-    return nullptr;
+    return mViasByUuid.value(uuid, nullptr);
 }
 
 void Board::addVia(BI_Via& via) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mVias.contains(&via)) || (&via.getBoard() != this)) {
+    if ((!mIsAddedToProject) || (getViaByUuid(via.getUuid()) == &via) || (&via.getBoard() != this)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no via with the same uuid in the list
@@ -639,16 +679,18 @@ void Board::addVia(BI_Via& via) throw (Exception)
     // add to board
     via.addToBoard(*mGraphicsScene); // can throw
     mVias.append(&via);
+    mViasByUuid.insert(via.getUuid(), &via);
 }
 
 void Board::removeVia(BI_Via& via) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mVias.contains(&via))) {
+    if ((!mIsAddedToProject) || (getViaByUuid(via.getUuid()) != &via)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
     via.removeFromBoard(*mGraphicsScene); // can throw
     mVias.removeOne(&via);
+    mViasByUuid.remove(via.getUuid());
 }
 
 /*****************************************************************************************
@@ -657,16 +699,12 @@ void Board::removeVia(BI_Via& via) throw (Exception)
 
 BI_NetPoint* Board::getNetPointByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (BI_NetPoint* netpoint, mNetPoints) {
-        if (netpoint->getUuid() == uuid)
-            return netpoint;
-    }
-    return nullptr;
+    return mNetPointsByUuid.value(uuid, nullptr);
 }
 
 void Board::addNetPoint(BI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetPoints.contains(&netpoint))
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) == &netpoint)
         || (&netpoint.getBoard() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -680,16 +718,18 @@ void Board::addNetPoint(BI_NetPoint& netpoint) throw (Exception)
     // add to board
     netpoint.addToBoard(*mGraphicsScene); // can throw
     mNetPoints.append(&netpoint);
+    mNetPointsByUuid.insert(netpoint.getUuid(), &netpoint);
 }
 
 void Board::removeNetPoint(BI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetPoints.contains(&netpoint))) {
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) != &netpoint)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
     netpoint.removeFromBoard(*mGraphicsScene); // can throw
     mNetPoints.removeOne(&netpoint);
+    mNetPointsByUuid.remove(netpoint.getUuid());
 }
 
 /*****************************************************************************************
@@ -698,16 +738,12 @@ void Board::removeNetPoint(BI_NetPoint& netpoint) throw (Exception)
 
 BI_NetLine* Board::getNetLineByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (BI_NetLine* netline, mNetLines) {
-        if (netline->getUuid() == uuid)
-            return netline;
-    }
-    return nullptr;
+    return mNetLinesByUuid.value(uuid, nullptr);
 }
 
 void Board::addNetLine(BI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetLines.contains(&netline))
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) == &netline)
         || (&netline.getBoard() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -721,16 +757,18 @@ void Board::addNetLine(BI_NetLine& netline) throw (Exception)
     // add to board
     netline.addToBoard(*mGraphicsScene); // can throw
     mNetLines.append(&netline);
+    mNetLinesByUuid.insert(netline.getUuid(), &netline);
 }
 
 void Board::removeNetLine(BI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetLines.contains(&netline))) {
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) != &netline)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
     netline.removeFromBoard(*mGraphicsScene); // can throw
     mNetLines.removeOne(&netline);
+    mNetLinesByUuid.remove(netline.getUuid());
 }
 
 /*****************************************************************************************
@@ -774,7 +812,7 @@ void Board::addToProject() throw (Exception)
         sgl.add([this, item](){item->removeFromBoard(*mGraphicsScene);});
     }
     mIsAddedToProject = true;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     sgl.dismiss();
 }
 
@@ -791,8 +829,15 @@ void Board::removeFromProject() throw (Exception)
         sgl.add([this, item](){item->addToBoard(*mGraphicsScene);});
     }
     mIsAddedToProject = false;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     sgl.dismiss();
+
+    // the air wires are rebuilt by the items when the board is added again
+    foreach (BGI_AirWires* airwires, mAirWires) {
+        mGraphicsScene->removeItem(*airwires);
+    }
+    qDeleteAll(mAirWires);          mAirWires.clear();
+    mScheduledAirWiresRebuilds.clear();
 }
 
 bool Board::save(bool toOriginal, QStringList& errors) noexcept
@@ -822,6 +867,33 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Board::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // take a snapshot of the board XML file
+    try
+    {
+        if (mIsAddedToProject)
+        {
+            QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+            doc->setFileVersion(APP_VERSION_MAJOR);
+            jobs.append(mXmlFile->prepareAutosave(doc)); // written later by the caller
+        }
+        else
+        {
+            mXmlFile->removeFile(false);
+        }
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
+    }
+
+    return success;
+}
+
 void Board::showInView(GraphicsView& view) noexcept
 {
     view.setScene(mGraphicsScene.data());
@@ -865,6 +937,72 @@ void Board::clearSelection() const noexcept
         netline->setSelected(false);
 }
 
+void Board::scheduleAirWiresRebuild(NetSignal* netsignal) noexcept
+{
+    if (!netsignal) return;
+    if (mScheduledAirWiresRebuilds.isEmpty()) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+        QTimer::singleShot(0, this, &Board::rebuildScheduledAirWires);
+#else
+        QTimer::singleShot(0, this, SLOT(rebuildScheduledAirWires()));
+#endif
+    }
+    mScheduledAirWiresRebuilds.insert(netsignal->getUuid());
+}
+
+void Board::runDesignRuleCheck() noexcept
+{
+    if (!mIsAddedToProject) return;
+
+    BoardDesignRuleCheck drc(*this);
+    drc.execute();
+
+    // reuse the messages of violations which still exist to keep their ignore state
+    QHash<QString, ErcMsg*> oldMessages = mErcMsgListDesignRuleViolations;
+    mErcMsgListDesignRuleViolations.clear();
+    foreach (const BoardDesignRuleCheck::Violation& violation, drc.getViolations())
+    {
+        QString msgKey;
+        QString itemKey = BoardDesignRuleCheck::getItemKey(*violation.item1);
+        QString msg;
+        if (violation.type == BoardDesignRuleCheck::Violation::Type_t::Clearance)
+        {
+            Q_ASSERT(violation.item2);
+            QString itemKey2 = BoardDesignRuleCheck::getItemKey(*violation.item2);
+            msgKey = "ClearanceViolation";
+            itemKey = (itemKey < itemKey2) ? QString("%1/%2").arg(itemKey, itemKey2)
+                                           : QString("%1/%2").arg(itemKey2, itemKey);
+            msg = QString(tr("Clearance Violation: %1 - %2 (%3mm, Board: %4)")).arg(
+                BoardDesignRuleCheck::getItemDescription(*violation.item1),
+                BoardDesignRuleCheck::getItemDescription(*violation.item2),
+                violation.value.toMmString(), mName);
+        }
+        else
+        {
+            msgKey = "MinWidthViolation";
+            msg = QString(tr("Minimum Width Violation: %1 (%2mm, Board: %3)")).arg(
+                BoardDesignRuleCheck::getItemDescription(*violation.item1),
+                violation.value.toMmString(), mName);
+        }
+        QString ownerKey = QString("%1/%2").arg(mUuid.toStr(), itemKey);
+        QString key = QString("%1/%2").arg(msgKey, ownerKey);
+        if (mErcMsgListDesignRuleViolations.contains(key)) continue;
+        ErcMsg* ercMsg = oldMessages.take(key);
+        if (ercMsg)
+        {
+            ercMsg->setMsg(msg);
+        }
+        else
+        {
+            ercMsg = new ErcMsg(mProject, *this, ownerKey, msgKey,
+                                ErcMsg::ErcMsgType_t::BoardError, msg);
+            ercMsg->setVisible(true);
+        }
+        mErcMsgListDesignRuleViolations.insert(key, ercMsg);
+    }
+    qDeleteAll(oldMessages);
+}
+
 /*****************************************************************************************
  *  Helper Methods
  ****************************************************************************************/
@@ -880,10 +1018,51 @@ bool Board::getAttributeValue(const QString& attrNS, const QString& attrKey,
     return false;
 }
 
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void Board::rebuildScheduledAirWires() noexcept
+{
+    QSet<Uuid> netsignals = mScheduledAirWiresRebuilds;
+    mScheduledAirWiresRebuilds.clear();
+    foreach (const Uuid& uuid, netsignals) {
+        rebuildAirWires(uuid);
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+QList<BI_Base*> Board::getItemCandidatesAtScenePos(const Point& pos) const noexcept
+{
+    // The BSP tree of the graphics scene is a spatial index of the bounding rects of all
+    // items added to the board. Qt keeps it up to date when items are added, removed,
+    // moved or change their geometry, so we don't need to scan all items of the board.
+    QList<BI_Base*> list;
+    foreach (QGraphicsItem* item, mGraphicsScene->items(pos.toPxQPointF(),
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        BGI_Base* boardItem = dynamic_cast<BGI_Base*>(item);
+        if (boardItem) {
+            list.append(&boardItem->getBoardItem());
+        }
+    }
+    return list;
+}
+
+QList<BI_Base*> Board::getItemCandidatesAtScenePos(const Point& pos, BI_Base::Type_t type) const noexcept
+{
+    QList<BI_Base*> list;
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (item->getType() == type) {
+            list.append(item);
+        }
+    }
+    return list;
+}
+
 void Board::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
@@ -943,6 +1122,11 @@ XmlDomElement* Board::serializeToXmlDomElement() const throw (Exception)
     return root.take();
 }
 
+void Board::scheduleErcMessagesUpdate() noexcept
+{
+    mProject.getErcMsgList().scheduleUpdate(*this, [this](){updateErcMessages();});
+}
+
 void Board::updateErcMessages() noexcept
 {
     // type: UnplacedComponent (ComponentInstances without DeviceInstance)
@@ -976,6 +1160,71 @@ void Board::updateErcMessages() noexcept
     {
         qDeleteAll(mErcMsgListUnplacedComponentInstances);
         mErcMsgListUnplacedComponentInstances.clear();
+        qDeleteAll(mErcMsgListDesignRuleViolations);
+        mErcMsgListDesignRuleViolations.clear();
+    }
+}
+
+void Board::rebuildAirWires(const Uuid& netsignal) noexcept
+{
+    NetSignal* signal = mProject.getCircuit().getNetSignalByUuid(netsignal);
+    AirWiresBuilder builder;
+    if (mIsAddedToProject && signal)
+    {
+        // pads and vias
+        QHash<const BI_FootprintPad*, int> padIndices;
+        QHash<const BI_Via*, int> viaIndices;
+        foreach (const ComponentSignalInstance* cmpSig, signal->getComponentSignals()) {
+            foreach (const BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
+                if ((&pad->getBoard() == this) && (pad->isAddedToBoard())) {
+                    padIndices.insert(pad, builder.addPoint(pad->getPosition()));
+                }
+            }
+        }
+        foreach (const BI_Via* via, signal->getBoardVias()) {
+            if (&via->getBoard() == this) {
+                viaIndices.insert(via, builder.addPoint(via->getPosition()));
+            }
+        }
+        // netpoints, connected to their pad or via
+        QHash<const BI_NetPoint*, int> netPointIndices;
+        foreach (const BI_NetPoint* netpoint, signal->getBoardNetPoints()) {
+            if (&netpoint->getBoard() != this) continue;
+            int index = builder.addPoint(netpoint->getPosition());
+            netPointIndices.insert(netpoint, index);
+            if (padIndices.contains(netpoint->getFootprintPad())) {
+                builder.addEdge(index, padIndices.value(netpoint->getFootprintPad()));
+            }
+            if (viaIndices.contains(netpoint->getVia())) {
+                builder.addEdge(index, viaIndices.value(netpoint->getVia()));
+            }
+        }
+        // traces
+        foreach (const BI_NetPoint* netpoint, netPointIndices.keys()) {
+            foreach (const BI_NetLine* netline, netpoint->getLines()) {
+                int start = netPointIndices.value(&netline->getStartPoint(), -1);
+                int end = netPointIndices.value(&netline->getEndPoint(), -1);
+                if ((start >= 0) && (end >= 0)) {
+                    builder.addEdge(start, end);
+                }
+            }
+        }
+    }
+
+    QList<AirWiresBuilder::AirWire> airwires = builder.buildAirWires();
+    BGI_AirWires* item = mAirWires.value(netsignal);
+    if (airwires.isEmpty()) {
+        if (item) {
+            mGraphicsScene->removeItem(*item);
+            delete mAirWires.take(netsignal);
+        }
+    } else {
+        if (!item) {
+            item = new BGI_AirWires(*this);
+            mGraphicsScene->addItem(*item);
+            mAirWires.insert(netsignal, item);
+        }
+        item->setAirWires(airwires);
     }
 }
 
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <QtWidgets>
 #include <librepcbcommon/if_attributeprovider.h>
 #include <librepcbcommon/fileio/if_xmlserializableobject.h>
@@ -32,6 +33,7 @@
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/uuid.h>
 #include "../erc/if_ercmsgprovider.h"
+#include "items/bi_base.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -42,6 +44,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartXmlFile;
+class XmlDomDocument;
 class BoardLayer;
 class BoardDesignRules;
 
@@ -57,6 +60,7 @@ class BI_NetPoint;
 class BI_NetLine;
 class BI_Polygon;
 class BoardLayerStack;
+class BGI_AirWires;
 
 /*****************************************************************************************
  *  Class Board
@@ -93,14 +97,16 @@ class Board final : public QObject, public IF_AttributeProvider,
             ZValue_FootprintPadsTop,    ///< Z value for #project#BI_FootprintPad items
             ZValue_FootprintsTop,       ///< Z value for #project#BI_Footprint items
             ZValue_Vias,                ///< Z value for #project#BI_Via items
+            ZValue_AirWires,            ///< Z value for #project#BGI_AirWires items
         };
 
         // Constructors / Destructor
         Board() = delete;
         Board(const Board& other) = delete;
         Board(const Board& other, const FilePath& filepath, const QString& name) throw (Exception);
-        Board(Project& project, const FilePath& filepath, bool restore, bool readOnly) throw (Exception) :
-            Board(project, filepath, restore, readOnly, false, QString()) {}
+        Board(Project& project, const FilePath& filepath, bool restore, bool readOnly,
+              const QSharedPointer<XmlDomDocument>& parsedDoc = QSharedPointer<XmlDomDocument>()) throw (Exception) :
+            Board(project, filepath, restore, readOnly, false, QString(), parsedDoc) {}
         ~Board() noexcept;
 
         // Getters: General
@@ -173,12 +179,32 @@ class Board final : public QObject, public IF_AttributeProvider,
         void addToProject() throw (Exception);
         void removeFromProject() throw (Exception);
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
         void showInView(GraphicsView& view) noexcept;
         void saveViewSceneRect(const QRectF& rect) noexcept {mViewRect = rect;}
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
         void setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept;
         void clearSelection() const noexcept;
 
+        /**
+         * @brief Run the design rule check (DRC) and update its ERC messages
+         *
+         * @see librepcb#project#BoardDesignRuleCheck
+         */
+        void runDesignRuleCheck() noexcept;
+
+        /**
+         * @brief Schedule a rebuild of the air wires of a net signal
+         *
+         * Items call this whenever they change the position or connectivity of the
+         * copper of a net. All scheduled net signals are rebuilt together once the event
+         * loop is entered again, so the air wires of nets which were not touched are not
+         * calculated again.
+         *
+         * @param netsignal     The net signal to rebuild (nullptr is ignored)
+         */
+        void scheduleAirWiresRebuild(NetSignal* netsignal) noexcept;
+
         // Helper Methods
         bool getAttributeValue(const QString& attrNS, const QString& attrKey,
                                bool passToParents, QString& value) const noexcept;
@@ -202,16 +228,38 @@ class Board final : public QObject, public IF_AttributeProvider,
         void deviceRemoved(BI_Device& comp);
 
 
+    private slots:
+
+        void rebuildScheduledAirWires() noexcept;
+
+
     private:
 
         Board(Project& project, const FilePath& filepath, bool restore,
-              bool readOnly, bool create, const QString& newName) throw (Exception);
+              bool readOnly, bool create, const QString& newName,
+              const QSharedPointer<XmlDomDocument>& parsedDoc = QSharedPointer<XmlDomDocument>()) throw (Exception);
         void updateIcon() noexcept;
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
 
+        void scheduleErcMessagesUpdate() noexcept;
         void updateErcMessages() noexcept;
+        void rebuildAirWires(const Uuid& netsignal) noexcept;
+
+        /**
+         * @brief Get all items whose bounding rect contains a given position
+         *
+         * The items are looked up in the spatial index of the graphics scene, so only
+         * items which are added to the board are returned. The returned items are only
+         * candidates, the caller has to check their grab area.
+         *
+         * @param pos   The scene position
+         *
+         * @return All found items (top most items first)
+         */
+        QList<BI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
+        QList<BI_Base*> getItemCandidatesAtScenePos(const Point& pos, BI_Base::Type_t type) const noexcept;
 
         /// @copydoc IF_XmlSerializableObject#serializeToXmlDomElement()
         XmlDomElement* serializeToXmlDomElement() const throw (Exception) override;
@@ -239,10 +287,18 @@ class Board final : public QObject, public IF_AttributeProvider,
         QList<BI_Via*> mVias;
         QList<BI_NetPoint*> mNetPoints;
         QList<BI_NetLine*> mNetLines;
+        QHash<Uuid, BI_Via*> mViasByUuid;           ///< index of #mVias
+        QHash<Uuid, BI_NetPoint*> mNetPointsByUuid; ///< index of #mNetPoints
+        QHash<Uuid, BI_NetLine*> mNetLinesByUuid;   ///< index of #mNetLines
         QList<BI_Polygon*> mPolygons;
 
+        // air wires
+        QSet<Uuid> mScheduledAirWiresRebuilds;      ///< UUIDs of net signals
+        QHash<Uuid, BGI_AirWires*> mAirWires;       ///< key: UUID of the net signal
+
         // ERC messages
         QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
+        QHash<QString, ErcMsg*> mErcMsgListDesignRuleViolations; ///< key: see #runDesignRuleCheck()
 };
 
 /*****************************************************************************************
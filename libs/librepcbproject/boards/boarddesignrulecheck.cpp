@@ -0,0 +1,306 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtConcurrent>
+#include "boarddesignrulecheck.h"
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_via.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentinstance.h"
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/boarddesignrules.h>
+#include <librepcblibrary/pkg/footprintpadtht.h>
+#include <librepcblibrary/pkg/packagepad.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardDesignRuleCheck::BoardDesignRuleCheck(const Board& board) noexcept :
+    mBoard(board), mClearance(board.getDesignRules().getCopperClearance())
+{
+}
+
+BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::execute() noexcept
+{
+    mLayers.clear();
+    mNetIds.clear();
+    mViolations.clear();
+
+    // copy the geometry of all items (the board must only be accessed by this thread)
+    collectItems();
+
+    // broad phase: build the grid of each layer
+    QtConcurrent::blockingMap(mLayers, [](Layer& layer){layer.checker.buildGrid();});
+
+    // narrow phase: split the cells of all layers into chunks and check them concurrently
+    int chunksPerLayer = qMax(1, QThread::idealThreadCount() * 4 / qMax(1, mLayers.count()));
+    QList<QFuture<QList<Violation>>> futures;
+    for (auto it = mLayers.constBegin(); it != mLayers.constEnd(); ++it) {
+        const Layer* layer = &it.value();
+        QVector<ClearanceChecker::CellIndex> cells = layer->checker.getCells();
+        int chunkSize = qMax(1, (cells.count() + chunksPerLayer - 1) / chunksPerLayer);
+        for (int i = 0; i < cells.count(); i += chunkSize) {
+            QVector<ClearanceChecker::CellIndex> chunk = cells.mid(i, chunkSize);
+            futures.append(QtConcurrent::run([this, layer, chunk](){
+                return checkCells(*layer, chunk);}));
+        }
+    }
+
+    // merge the results, items on several layers (vias, THT pads) are reported only once
+    QHash<QPair<const BI_Base*, const BI_Base*>, int> clearanceViolations;
+    foreach (const QFuture<QList<Violation>>& future, futures) {
+        foreach (const Violation& violation, future.result()) {
+            QPair<const BI_Base*, const BI_Base*> key = (violation.item1 < violation.item2)
+                ? qMakePair(violation.item1, violation.item2)
+                : qMakePair(violation.item2, violation.item1);
+            int index = clearanceViolations.value(key, -1);
+            if (index < 0) {
+                clearanceViolations.insert(key, mViolations.count());
+                mViolations.append(violation);
+            } else if (violation.value < mViolations.at(index).value) {
+                mViolations[index] = violation;
+            }
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString BoardDesignRuleCheck::getItemKey(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::NetLine: {
+            return static_cast<const BI_NetLine&>(item).getUuid().toStr();
+        }
+        case BI_Base::Type_t::Via: {
+            return static_cast<const BI_Via&>(item).getUuid().toStr();
+        }
+        case BI_Base::Type_t::FootprintPad: {
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            return QString("%1/%2").arg(pad.getFootprint().getComponentInstanceUuid().toStr(),
+                                        pad.getLibPadUuid().toStr());
+        }
+        default: {
+            Q_ASSERT(false);
+            return QString();
+        }
+    }
+}
+
+QString BoardDesignRuleCheck::getItemDescription(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::NetLine: {
+            const BI_NetLine& netline = static_cast<const BI_NetLine&>(item);
+            return QString(tr("Trace of net \"%1\"")).arg(netline.getNetSignal().getName());
+        }
+        case BI_Base::Type_t::Via: {
+            const BI_Via& via = static_cast<const BI_Via&>(item);
+            if (via.getNetSignal()) {
+                return QString(tr("Via of net \"%1\"")).arg(via.getNetSignal()->getName());
+            } else {
+                return tr("Unconnected via");
+            }
+        }
+        case BI_Base::Type_t::FootprintPad: {
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            return QString(tr("Pad \"%1\" of \"%2\"")).arg(pad.getLibPackagePad().getName(),
+                pad.getFootprint().getDeviceInstance().getComponentInstance().getName());
+        }
+        default: {
+            Q_ASSERT(false);
+            return QString();
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::collectItems() noexcept
+{
+    const Length& minWidth = mBoard.getDesignRules().getCopperMinWidth();
+
+    // the outer copper layers are always checked, inner layers only if they are used
+    addLayer(BoardLayer::TopCopper);
+    addLayer(BoardLayer::BottomCopper);
+
+    // traces
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        Q_ASSERT(netline);
+        int layerId = netline->getLayer().getId();
+        if (!BoardLayer::isCopperLayer(layerId)) continue;
+        addItemToLayer(layerId, createNetLineItem(*netline));
+        if (netline->getWidth() < minWidth) {
+            mViolations.append(Violation{Violation::Type_t::MinWidth, layerId, netline,
+                                         nullptr, netline->getWidth()});
+        }
+    }
+
+    // SMT pads (THT pads are added later to all layers)
+    QList<const BI_FootprintPad*> thtPads;
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        Q_ASSERT(device);
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            Q_ASSERT(pad);
+            if (pad->getLibPad().getTechnology() == library::FootprintPad::Technology_t::THT) {
+                thtPads.append(pad);
+            } else if (BoardLayer::isCopperLayer(pad->getLayerId())) {
+                addItemToLayer(pad->getLayerId(), createPadItem(*pad));
+            }
+        }
+    }
+
+    // THT pads and vias
+    foreach (int layerId, mLayers.keys()) {
+        foreach (const BI_FootprintPad* pad, thtPads) {
+            if (pad->isOnLayer(layerId)) {
+                addItemToLayer(layerId, createPadItem(*pad));
+            }
+        }
+        foreach (const BI_Via* via, mBoard.getVias()) {
+            Q_ASSERT(via);
+            if (via->isOnLayer(layerId)) {
+                addItemToLayer(layerId, createViaItem(*via));
+            }
+        }
+    }
+}
+
+void BoardDesignRuleCheck::addLayer(int layerId) noexcept
+{
+    if (!mLayers.contains(layerId)) {
+        mLayers.insert(layerId, Layer{layerId, QVector<const BI_Base*>(),
+                                      ClearanceChecker(mClearance)});
+    }
+}
+
+void BoardDesignRuleCheck::addItemToLayer(int layerId, const Item& item) noexcept
+{
+    // each net signal gets an ID, unconnected items are never of the same net
+    int netId = -1;
+    if (item.netsignal) {
+        netId = mNetIds.value(item.netsignal, mNetIds.count());
+        mNetIds.insert(item.netsignal, netId);
+    }
+    addLayer(layerId);
+    Layer& layer = mLayers[layerId];
+    layer.items.append(item.item);
+    layer.checker.addItem(item.shape, netId);
+}
+
+QList<BoardDesignRuleCheck::Violation> BoardDesignRuleCheck::checkCells(
+    const Layer& layer, const QVector<ClearanceChecker::CellIndex>& cells) const noexcept
+{
+    QList<Violation> violations;
+    foreach (const ClearanceChecker::Violation& violation, layer.checker.checkCells(cells)) {
+        violations.append(Violation{Violation::Type_t::Clearance, layer.layerId,
+                                    layer.items.at(violation.item1),
+                                    layer.items.at(violation.item2), violation.clearance});
+    }
+    return violations;
+}
+
+BoardDesignRuleCheck::Item BoardDesignRuleCheck::createNetLineItem(const BI_NetLine& netline) const noexcept
+{
+    return Item{&netline, &netline.getNetSignal(), ClearanceChecker::createTraceShape(
+        netline.getStartPoint().getPosition(), netline.getEndPoint().getPosition(),
+        netline.getWidth())};
+}
+
+BoardDesignRuleCheck::Item BoardDesignRuleCheck::createViaItem(const BI_Via& via) const noexcept
+{
+    const Point& pos = via.getPosition();
+    const Length& size = via.getSize();
+    switch (via.getShape())
+    {
+        case BI_Via::Shape::Square: {
+            return Item{&via, via.getNetSignal(),
+                        ClearanceChecker::createRectShape(pos, size, size, Angle::deg0())};
+        }
+        case BI_Via::Shape::Octagon: {
+            return Item{&via, via.getNetSignal(),
+                        ClearanceChecker::createOctagonShape(pos, size, size, Angle::deg0())};
+        }
+        default: {
+            return Item{&via, via.getNetSignal(),
+                        ClearanceChecker::createObroundShape(pos, size, size, Angle::deg0())};
+        }
+    }
+}
+
+BoardDesignRuleCheck::Item BoardDesignRuleCheck::createPadItem(const BI_FootprintPad& pad) const noexcept
+{
+    const library::FootprintPad& libPad = pad.getLibPad();
+    const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&libPad);
+    library::FootprintPadTht::Shape_t shape = tht ? tht->getShape()
+                                                  : library::FootprintPadTht::Shape_t::RECT;
+    Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
+    switch (shape)
+    {
+        case library::FootprintPadTht::Shape_t::ROUND: {
+            return Item{&pad, pad.getCompSigInstNetSignal(), ClearanceChecker::createObroundShape(
+                pad.getPosition(), libPad.getWidth(), libPad.getHeight(), rot)};
+        }
+        case library::FootprintPadTht::Shape_t::OCTAGON: {
+            return Item{&pad, pad.getCompSigInstNetSignal(), ClearanceChecker::createOctagonShape(
+                pad.getPosition(), libPad.getWidth(), libPad.getHeight(), rot)};
+        }
+        default: {
+            return Item{&pad, pad.getCompSigInstNetSignal(), ClearanceChecker::createRectShape(
+                pad.getPosition(), libPad.getWidth(), libPad.getHeight(), rot)};
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
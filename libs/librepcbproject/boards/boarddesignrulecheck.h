@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/clearancechecker.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+class BI_NetLine;
+class BI_Via;
+class BI_FootprintPad;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardDesignRuleCheck
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheck (DRC) class checks a board against its design rules
+ *
+ * Checked rules:
+ *  - The copper clearance between traces, vias and pads of different net signals
+ *    (see librepcb#BoardDesignRules#getCopperClearance())
+ *  - The minimum width of traces (see librepcb#BoardDesignRules#getCopperMinWidth())
+ *
+ * The geometry of all copper items is copied on the calling thread, then the clearance
+ * checks are done concurrently by the global thread pool. The clearance of each copper
+ * layer is checked by a librepcb#ClearanceChecker, whose grid cells are split into
+ * chunks to check them on several threads.
+ *
+ * @note #execute() blocks until all worker threads are finished, so the board must not
+ *       be modified while the check is running.
+ */
+class BoardDesignRuleCheck final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardDesignRuleCheck)
+
+    public:
+
+        // Types
+        struct Violation {
+            enum class Type_t {
+                Clearance,  ///< two items of different nets are too close together
+                MinWidth,   ///< a trace is thinner than allowed
+            };
+            Type_t type;
+            int layerId;            ///< the copper layer where the violation was found
+            const BI_Base* item1;
+            const BI_Base* item2;   ///< nullptr if the violation affects only one item
+            Length value;           ///< the actual clearance or width
+        };
+
+        // Constructors / Destructor
+        BoardDesignRuleCheck() = delete;
+        BoardDesignRuleCheck(const BoardDesignRuleCheck& other) = delete;
+        explicit BoardDesignRuleCheck(const Board& board) noexcept;
+        ~BoardDesignRuleCheck() noexcept;
+
+        // Getters
+        const QList<Violation>& getViolations() const noexcept {return mViolations;}
+
+        // General Methods
+        void execute() noexcept;
+
+        // Operator Overloadings
+        BoardDesignRuleCheck& operator=(const BoardDesignRuleCheck& rhs) = delete;
+
+        // Static Methods
+        static QString getItemKey(const BI_Base& item) noexcept;
+        static QString getItemDescription(const BI_Base& item) noexcept;
+
+
+    private:
+
+        // Types
+        struct Item {
+            const BI_Base* item;
+            const NetSignal* netsignal; ///< nullptr for unconnected pads
+            ClearanceChecker::Shape shape;
+        };
+        struct Layer {
+            int layerId;
+            QVector<const BI_Base*> items;  ///< same indices as in #checker
+            ClearanceChecker checker;
+        };
+
+        // Private Methods
+        void collectItems() noexcept;
+        void addLayer(int layerId) noexcept;
+        void addItemToLayer(int layerId, const Item& item) noexcept;
+        QList<Violation> checkCells(const Layer& layer,
+                                    const QVector<ClearanceChecker::CellIndex>& cells) const noexcept;
+        Item createNetLineItem(const BI_NetLine& netline) const noexcept;
+        Item createViaItem(const BI_Via& via) const noexcept;
+        Item createPadItem(const BI_FootprintPad& pad) const noexcept;
+
+
+        // Attributes
+        const Board& mBoard;
+        Length mClearance;
+        QMap<int, Layer> mLayers;
+        QHash<const NetSignal*, int> mNetIds;   ///< the nets passed to the checkers
+        QList<Violation> mViolations;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
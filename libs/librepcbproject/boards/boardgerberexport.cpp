@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtConcurrent>
 #include "boardgerberexport.h"
 #include <librepcbcommon/cam/gerbergenerator.h>
 #include <librepcbcommon/cam/excellongenerator.h>
@@ -51,300 +52,431 @@ namespace project {
  ****************************************************************************************/
 
 BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept :
-    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir)
+    mBoard(board), mOutputDirectory(outputDir), mCancelRequested(0)
 {
 }
 
 BoardGerberExport::~BoardGerberExport() noexcept
 {
+    clearItems();
 }
 
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportAllLayers() const throw (Exception)
+void BoardGerberExport::exportAllLayers() throw (Exception)
 {
-    exportDrillsPTH();
-    exportLayerBoardOutlines();
-    exportLayerTopCopper();
-    exportLayerTopSolderMask();
-    exportLayerTopOverlay();
-    exportLayerBottomCopper();
-    exportLayerBottomSolderMask();
-    exportLayerBottomOverlay();
+    typedef void (BoardGerberExport::*ExportFunction)() const;
+    QList<ExportFunction> functions = {
+        &BoardGerberExport::exportDrillsNPTH,
+        &BoardGerberExport::exportDrillsPTH,
+        &BoardGerberExport::exportLayerBoardOutlines,
+        &BoardGerberExport::exportLayerTopCopper,
+        &BoardGerberExport::exportLayerTopSolderMask,
+        &BoardGerberExport::exportLayerTopOverlay,
+        &BoardGerberExport::exportLayerBottomCopper,
+        &BoardGerberExport::exportLayerBottomSolderMask,
+        &BoardGerberExport::exportLayerBottomOverlay,
+    };
+
+    // copy the geometry of all items (the board must only be accessed by this thread)
+    collectItems();
+
+    // generate and write each file in a worker thread
+    mCancelRequested.store(0);
+    QList<QFuture<void>> futures;
+    foreach (ExportFunction function, functions) {
+        futures.append(QtConcurrent::run([this, function]() {
+            try {
+                (this->*function)();
+            } catch (...) {
+                cancel(); // the other files are useless without this one
+                throw;
+            }
+        }));
+    }
+
+    // report the progress in the order the files are finished, and process events
+    // until all of them are finished (so the caller is able to cancel the export)
+    QEventLoop eventLoop;
+    QList<QSharedPointer<QFutureWatcher<void>>> watchers;
+    int finishedFiles = 0;
+    emit progress(finishedFiles, futures.count());
+    foreach (const QFuture<void>& future, futures) {
+        QSharedPointer<QFutureWatcher<void>> watcher(new QFutureWatcher<void>());
+        connect(watcher.data(), &QFutureWatcher<void>::finished,
+                [this, &finishedFiles, &futures, &eventLoop]() {
+            emit progress(++finishedFiles, futures.count());
+            if (finishedFiles == futures.count()) eventLoop.quit();
+        });
+        watcher->setFuture(future);
+        watchers.append(watcher);
+    }
+    if (finishedFiles < futures.count()) {
+        eventLoop.exec();
+    }
+
+    // rethrow errors (by waitForFinished()), but report canceling only if it actually
+    // prevented writing any file
+    bool canceled = false;
+    foreach (QFuture<void> future, futures) {
+        try {
+            future.waitForFinished();
+        } catch (const UserCanceled&) {
+            canceled = true;
+        }
+    }
+    if (canceled) {
+        throw UserCanceled(__FILE__, __LINE__);
+    }
+}
+
+void BoardGerberExport::cancel() noexcept
+{
+    mCancelRequested.store(1);
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportDrillsPTH() const throw (Exception)
+void BoardGerberExport::throwIfCanceled() const throw (UserCanceled)
 {
-    ExcellonGenerator gen;
+    if (mCancelRequested.load()) {
+        throw UserCanceled(__FILE__, __LINE__);
+    }
+}
 
-    // footprint holes and pads
+void BoardGerberExport::collectItems() throw (Exception)
+{
+    clearItems();
+    mProjectName = mBoard.getProject().getName();
+    mBoardUuid = mBoard.getUuid();
+    mBoardName = mBoard.getName();
+
+    // footprints
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        Q_ASSERT(device);
         const BI_Footprint& footprint = device->getFootprint();
-        for (int i = 0; i < footprint.getLibFootprint().getHoleCount(); ++i) {
-            const Hole* hole = footprint.getLibFootprint().getHole(i); Q_ASSERT(hole);
-            gen.drill(footprint.mapToScene(hole->getPosition()), hole->getDiameter());
-        }
+        const library::Footprint& libFootprint = footprint.getLibFootprint();
+        Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
         foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-            const library::FootprintPad& libPad = pad->getLibPad();
-            if (libPad.getTechnology() == library::FootprintPad::Technology_t::THT) {
-                const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&libPad); Q_ASSERT(tht);
-                gen.drill(pad->getPosition(), tht->getDrillDiameter());
+            Q_ASSERT(pad);
+            mPads.append(createPadItem(*pad));
+            const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&pad->getLibPad());
+            if (tht) {
+                mDrillsPth.append(DrillItem{pad->getPosition(), tht->getDrillDiameter()});
+            }
+        }
+        for (int i = 0; i < libFootprint.getPolygonCount(); ++i) {
+            const Polygon* polygon = libFootprint.getPolygon(i); Q_ASSERT(polygon);
+            Polygon* p = new Polygon(polygon->rotated(rot).translate(footprint.getPosition()));
+            p->setLineWidth(calcWidthOfLayer(p->getLineWidth(), p->getLayerId()));
+            if (footprint.getIsMirrored()) {
+                p->setLayerId(BoardLayer::getMirroredLayerId(p->getLayerId()));
+            }
+            mFootprintPolygons.append(p);
+        }
+        for (int i = 0; i < libFootprint.getEllipseCount(); ++i) {
+            const Ellipse* ellipse = libFootprint.getEllipse(i); Q_ASSERT(ellipse);
+            Ellipse* e = new Ellipse(ellipse->rotated(rot).translate(footprint.getPosition()));
+            e->setLineWidth(calcWidthOfLayer(e->getLineWidth(), e->getLayerId()));
+            if (footprint.getIsMirrored()) {
+                e->setLayerId(BoardLayer::getMirroredLayerId(e->getLayerId()));
             }
+            mFootprintEllipses.append(e);
+        }
+        for (int i = 0; i < libFootprint.getHoleCount(); ++i) {
+            const Hole* hole = libFootprint.getHole(i); Q_ASSERT(hole);
+            mDrillsNpth.append(DrillItem{footprint.mapToScene(hole->getPosition()),
+                                         hole->getDiameter()});
         }
     }
 
     // vias
     foreach (const BI_Via* via, mBoard.getVias()) {
-        gen.drill(via->getPosition(), via->getDrillDiameter());
+        Q_ASSERT(via);
+        mVias.append(createViaItem(*via));
+        mDrillsPth.append(DrillItem{via->getPosition(), via->getDrillDiameter()});
+    }
+
+    // traces
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        Q_ASSERT(netline);
+        mTraces.append(TraceItem{netline->getLayer().getId(),
+                                 netline->getStartPoint().getPosition(),
+                                 netline->getEndPoint().getPosition(),
+                                 netline->getWidth()});
     }
 
+    // polygons
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        Q_ASSERT(polygon);
+        mBoardPolygons.append(new Polygon(polygon->getPolygon()));
+    }
+}
+
+void BoardGerberExport::clearItems() noexcept
+{
+    mDrillsNpth.clear();
+    mDrillsPth.clear();
+    mPads.clear();
+    mVias.clear();
+    mTraces.clear();
+    qDeleteAll(mFootprintPolygons);     mFootprintPolygons.clear();
+    qDeleteAll(mFootprintEllipses);     mFootprintEllipses.clear();
+    qDeleteAll(mBoardPolygons);         mBoardPolygons.clear();
+}
+
+BoardGerberExport::PadItem BoardGerberExport::createPadItem(const BI_FootprintPad& pad) const throw (Exception)
+{
+    const library::FootprintPad& libPad = pad.getLibPad();
+    PadItem item;
+    item.position = pad.getPosition();
+    item.rotation = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
+    item.width = libPad.getWidth();
+    item.height = libPad.getHeight();
+    item.hasStopMask = true;
+    item.stopMaskClearance = mBoard.getDesignRules().calcStopMaskClearance(
+                                 qMin(item.width, item.height));
+    if (pad.isOnLayer(BoardLayer::TopCopper)) item.copperLayers.insert(BoardLayer::TopCopper);
+    if (pad.isOnLayer(BoardLayer::BottomCopper)) item.copperLayers.insert(BoardLayer::BottomCopper);
+
+    switch (libPad.getTechnology())
+    {
+        case library::FootprintPad::Technology_t::SMT: {
+            item.shape = PadItem::Shape_t::Rect;
+            break;
+        }
+        case library::FootprintPad::Technology_t::THT: {
+            const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&libPad); Q_ASSERT(tht);
+            switch (tht->getShape())
+            {
+                case library::FootprintPadTht::Shape_t::ROUND:   item.shape = PadItem::Shape_t::Round; break;
+                case library::FootprintPadTht::Shape_t::RECT:    item.shape = PadItem::Shape_t::Rect; break;
+                case library::FootprintPadTht::Shape_t::OCTAGON: item.shape = PadItem::Shape_t::Octagon; break;
+                default: throw LogicError(__FILE__, __LINE__);
+            }
+            break;
+        }
+        default: {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return item;
+}
+
+BoardGerberExport::PadItem BoardGerberExport::createViaItem(const BI_Via& via) const throw (Exception)
+{
+    PadItem item;
+    item.position = via.getPosition();
+    item.rotation = Angle::deg0();
+    item.width = via.getSize();
+    item.height = via.getSize();
+    item.hasStopMask = mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
+    item.stopMaskClearance = mBoard.getDesignRules().calcStopMaskClearance(via.getSize());
+    if (via.isOnLayer(BoardLayer::TopCopper)) item.copperLayers.insert(BoardLayer::TopCopper);
+    if (via.isOnLayer(BoardLayer::BottomCopper)) item.copperLayers.insert(BoardLayer::BottomCopper);
+
+    switch (via.getShape())
+    {
+        case BI_Via::Shape::Round:   item.shape = PadItem::Shape_t::Round; break;
+        case BI_Via::Shape::Square:  item.shape = PadItem::Shape_t::Rect; break;
+        case BI_Via::Shape::Octagon: item.shape = PadItem::Shape_t::Octagon; break;
+        default: throw LogicError(__FILE__, __LINE__);
+    }
+    return item;
+}
+
+void BoardGerberExport::exportDrillsNPTH() const throw (Exception)
+{
+    ExcellonGenerator gen;
+    foreach (const DrillItem& drill, mDrillsNpth) {
+        gen.drill(drill.position, drill.diameter);
+    }
+    throwIfCanceled();
+    gen.generate();
+    QString filename = QString("%1_DRILLS-NPTH.drl").arg(mProjectName);
+    throwIfCanceled();
+    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+}
+
+void BoardGerberExport::exportDrillsPTH() const throw (Exception)
+{
+    ExcellonGenerator gen;
+    foreach (const DrillItem& drill, mDrillsPth) {
+        gen.drill(drill.position, drill.diameter);
+    }
+    throwIfCanceled();
     gen.generate();
-    QString filename = QString("%1_DRILLS-PTH.drl").arg(mProject.getName());
+    QString filename = QString("%1_DRILLS-PTH.drl").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerBoardOutlines() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::BoardOutlines);
-    gen.generate();
-    QString filename = QString("%1_OUTLINES.gbr").arg(mProject.getName());
+    QString filename = QString("%1_OUTLINES.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerTopCopper() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::TopCopper);
-    gen.generate();
-    QString filename = QString("%1_COPPER-TOP.gbr").arg(mProject.getName());
+    QString filename = QString("%1_COPPER-TOP.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerTopSolderMask() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::TopStopMask);
-    gen.generate();
-    QString filename = QString("%1_SOLDERMASK-TOP.gbr").arg(mProject.getName());
+    QString filename = QString("%1_SOLDERMASK-TOP.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerTopOverlay() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::TopOverlay);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, BoardLayer::TopStopMask);
-    gen.generate();
-    QString filename = QString("%1_SILKSCREEN-TOP.gbr").arg(mProject.getName());
+    QString filename = QString("%1_SILKSCREEN-TOP.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerBottomCopper() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::BottomCopper);
-    gen.generate();
-    QString filename = QString("%1_COPPER-BOTTOM.gbr").arg(mProject.getName());
+    QString filename = QString("%1_COPPER-BOTTOM.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerBottomSolderMask() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::BottomStopMask);
-    gen.generate();
-    QString filename = QString("%1_SOLDERMASK-BOTTOM.gbr").arg(mProject.getName());
+    QString filename = QString("%1_SOLDERMASK-BOTTOM.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::exportLayerBottomOverlay() const throw (Exception)
 {
-    GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
+    GerberGenerator gen(mProjectName, mBoardUuid, mBoardName);
     drawLayer(gen, BoardLayer::BottomOverlay);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, BoardLayer::BottomStopMask);
-    gen.generate();
-    QString filename = QString("%1_SILKSCREEN-BOTTOM.gbr").arg(mProject.getName());
+    QString filename = QString("%1_SILKSCREEN-BOTTOM.gbr").arg(mProjectName);
+    throwIfCanceled();
     gen.saveToFile(mOutputDirectory.getPathTo(filename));
 }
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen, int layerId) const throw (Exception)
 {
-    // draw footprints incl. pads
-    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-        Q_ASSERT(device);
-        drawFootprint(gen, device->getFootprint(), layerId);
-    }
-
-    // draw vias
-    foreach (const BI_Via* via, mBoard.getVias()) {
-        Q_ASSERT(via);
-        drawVia(gen, *via, layerId);
-    }
+    throwIfCanceled();
 
-    // draw traces
-    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
-        Q_ASSERT(netline);
-        if (netline->getLayer().getId() == layerId) {
-            gen.drawLine(netline->getStartPoint().getPosition(),
-                         netline->getEndPoint().getPosition(),
-                         netline->getWidth());
-        }
+    // draw footprint pads
+    foreach (const PadItem& pad, mPads) {
+        drawPad(gen, pad, layerId);
     }
 
-    // draw polygons
-    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
-        Q_ASSERT(polygon);
-        if (layerId == polygon->getPolygon().getLayerId()) {
-            Polygon p(polygon->getPolygon());
-            p.setLineWidth(calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerId));
-            gen.drawPolygonOutline(p);
+    // draw footprint polygons
+    foreach (const Polygon* polygon, mFootprintPolygons) {
+        if (polygon->getLayerId() == layerId) {
+            gen.drawPolygonOutline(*polygon);
+            if (polygon->isFilled()) {
+                gen.drawPolygonArea(*polygon);
+            }
         }
     }
-}
 
-void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, int layerId) const throw (Exception)
-{
-    bool drawCopper = via.isOnLayer(layerId);
-    bool drawStopMask = (layerId == BoardLayer::TopStopMask || layerId == BoardLayer::BottomStopMask)
-                        && mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
-    if (drawCopper || drawStopMask) {
-        Length outerDiameter = via.getSize();
-        if (drawStopMask) {
-            outerDiameter += mBoard.getDesignRules().calcStopMaskClearance(via.getSize()) * 2;
-        }
-        switch (via.getShape())
-        {
-            case BI_Via::Shape::Round: {
-                gen.flashCircle(via.getPosition(), outerDiameter, Length(0));
-                break;
-            }
-            case BI_Via::Shape::Square: {
-                gen.flashRect(via.getPosition(), outerDiameter, outerDiameter,
-                              Angle::deg0(), Length(0));
-                break;
-            }
-            case BI_Via::Shape::Octagon: {
-                gen.flashRegularPolygon(via.getPosition(), outerDiameter, 8,
-                                        Angle::deg0(), Length(0));
-                break;
-            }
-            default: {
-                throw LogicError(__FILE__, __LINE__);
+    // draw footprint ellipses
+    foreach (const Ellipse* ellipse, mFootprintEllipses) {
+        if (ellipse->getLayerId() == layerId) {
+            gen.drawEllipseOutline(*ellipse);
+            if (ellipse->isFilled()) {
+                gen.drawEllipseArea(*ellipse);
             }
         }
     }
-}
 
-void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, int layerId) const throw (Exception)
-{
-    // draw pads
-    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-        drawFootprintPad(gen, *pad, layerId);
+    // TODO: draw footprint texts
+
+    // draw footprint holes
+    foreach (const DrillItem& hole, mDrillsNpth) {
+        gen.flashCircle(hole.position, hole.diameter, Length(0));
     }
 
-    // draw polygons
-    for (int i = 0; i < footprint.getLibFootprint().getPolygonCount(); ++i) {
-        const Polygon* polygon = footprint.getLibFootprint().getPolygon(i); Q_ASSERT(polygon);
-        int layer = footprint.getIsMirrored() ? BoardLayer::getMirroredLayerId(layerId) : layerId;
-        if (layer == polygon->getLayerId()) {
-            Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
-            Polygon p = polygon->rotated(rot).translate(footprint.getPosition());
-            p.setLineWidth(calcWidthOfLayer(p.getLineWidth(), layer));
-            gen.drawPolygonOutline(p);
-            if (p.isFilled()) {
-                gen.drawPolygonArea(p);
-            }
-        }
+    // draw vias
+    foreach (const PadItem& via, mVias) {
+        drawPad(gen, via, layerId);
     }
 
-    // draw ellipses
-    for (int i = 0; i < footprint.getLibFootprint().getEllipseCount(); ++i) {
-        const Ellipse* ellipse = footprint.getLibFootprint().getEllipse(i); Q_ASSERT(ellipse);
-        int layer = footprint.getIsMirrored() ? BoardLayer::getMirroredLayerId(layerId) : layerId;
-        if (layer == ellipse->getLayerId()) {
-            Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
-            Ellipse e = ellipse->rotated(rot).translate(footprint.getPosition());
-            e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), layer));
-            gen.drawEllipseOutline(e);
-            if (e.isFilled()) {
-                gen.drawEllipseArea(e);
-            }
+    // draw traces
+    foreach (const TraceItem& trace, mTraces) {
+        if (trace.layerId == layerId) {
+            gen.drawLine(trace.startPos, trace.endPos, trace.width);
         }
     }
 
-    // TODO: draw texts
-
-    // draw holes
-    for (int i = 0; i < footprint.getLibFootprint().getHoleCount(); ++i) {
-        const Hole* hole = footprint.getLibFootprint().getHole(i); Q_ASSERT(hole);
-        gen.flashCircle(footprint.mapToScene(hole->getPosition()), hole->getDiameter(), Length(0));
+    // draw polygons
+    foreach (const Polygon* polygon, mBoardPolygons) {
+        if (polygon->getLayerId() == layerId) {
+            Polygon p(*polygon);
+            p.setLineWidth(calcWidthOfLayer(polygon->getLineWidth(), layerId));
+            gen.drawPolygonOutline(p);
+        }
     }
 }
 
-void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, int layerId) const throw (Exception)
+void BoardGerberExport::drawPad(GerberGenerator& gen, const PadItem& pad, int layerId) const throw (Exception)
 {
-    bool isOnCopperLayer = pad.isOnLayer(layerId);
-    bool isOnSolderMaskTop = pad.isOnLayer(BoardLayer::LayerID::TopCopper) && (layerId == BoardLayer::LayerID::TopStopMask);
-    bool isOnSolderMaskBottom = pad.isOnLayer(BoardLayer::LayerID::BottomCopper) && (layerId == BoardLayer::LayerID::BottomStopMask);
-    if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom) {
+    bool isOnCopperLayer = pad.copperLayers.contains(layerId);
+    bool isOnSolderMaskTop = pad.copperLayers.contains(BoardLayer::LayerID::TopCopper) && (layerId == BoardLayer::LayerID::TopStopMask);
+    bool isOnSolderMaskBottom = pad.copperLayers.contains(BoardLayer::LayerID::BottomCopper) && (layerId == BoardLayer::LayerID::BottomStopMask);
+    bool isOnSolderMask = pad.hasStopMask && (isOnSolderMaskTop || isOnSolderMaskBottom);
+    if (!isOnCopperLayer && !isOnSolderMask) {
         return;
     }
 
-    Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
-    const library::FootprintPad& libPad = pad.getLibPad();
-    Length width = libPad.getWidth();
-    Length height = libPad.getHeight();
-    if (isOnSolderMaskTop || isOnSolderMaskBottom) {
-        Length size = qMin(width, height);
-        Length clearance = mBoard.getDesignRules().calcStopMaskClearance(size);
-        width += clearance*2;
-        height += clearance*2;
+    Length width = pad.width;
+    Length height = pad.height;
+    if (isOnSolderMask) {
+        width += pad.stopMaskClearance*2;
+        height += pad.stopMaskClearance*2;
     }
 
-    switch (libPad.getTechnology())
+    switch (pad.shape)
     {
-        case library::FootprintPad::Technology_t::SMT: {
-            //const library::FootprintPadSmt* smt = dynamic_cast<const library::FootprintPadSmt*>(&libPad); Q_ASSERT(smt);
-            gen.flashRect(pad.getPosition(), width, height, rot, Length(0));
+        case PadItem::Shape_t::Round: {
+            if (width == height) {
+                gen.flashCircle(pad.position, width, Length(0));
+            } else {
+                gen.flashObround(pad.position, width, height, pad.rotation, Length(0));
+            }
             break;
         }
-        case library::FootprintPad::Technology_t::THT: {
-            const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&libPad); Q_ASSERT(tht);
-            switch (tht->getShape())
-            {
-                case library::FootprintPadTht::Shape_t::ROUND: {
-                    if (width == height) {
-                        gen.flashCircle(pad.getPosition(), width, Length(0));
-                    } else {
-                        gen.flashObround(pad.getPosition(), width, height, rot, Length(0));
-                    }
-                    break;
-                }
-                case library::FootprintPadTht::Shape_t::RECT: {
-                    gen.flashRect(pad.getPosition(), width, height, rot, Length(0));
-                    break;
-                }
-                case library::FootprintPadTht::Shape_t::OCTAGON: {
-                    if (width != height) {
-                        throw LogicError(__FILE__, __LINE__, QString(),
-                            tr("Sorry, non-square octagons are not yet supported."));
-                    }
-                    gen.flashRegularPolygon(pad.getPosition(), width, 8, rot, Length(0));
-                    break;
-                }
-                default: {
-                    throw LogicError(__FILE__, __LINE__);
-                }
+        case PadItem::Shape_t::Rect: {
+            gen.flashRect(pad.position, width, height, pad.rotation, Length(0));
+            break;
+        }
+        case PadItem::Shape_t::Octagon: {
+            if (width != height) {
+                throw LogicError(__FILE__, __LINE__, QString(),
+                    tr("Sorry, non-square octagons are not yet supported."));
             }
+            gen.flashRegularPolygon(pad.position, width, 8, pad.rotation, Length(0));
             break;
         }
         default: {
@@ -27,6 +27,7 @@
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/fileio/filepath.h>
 #include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/uuid.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -39,10 +40,8 @@ class GerberGenerator;
 
 namespace project {
 
-class Project;
 class Board;
 class BI_Via;
-class BI_Footprint;
 class BI_FootprintPad;
 
 /*****************************************************************************************
@@ -52,6 +51,11 @@ class BI_FootprintPad;
 /**
  * @brief The BoardGerberExport class
  *
+ * All output files are generated and written concurrently by a thread pool. The geometry
+ * of all items is copied from the board on the calling thread before the worker threads
+ * are started, and the worker threads only access this copy. So the board may be
+ * modified (or even deleted) while #exportAllLayers() processes events.
+ *
  * @author ubruhin
  * @date 2016-01-10
  */
@@ -68,15 +72,75 @@ class BoardGerberExport final : public QObject
         ~BoardGerberExport() noexcept;
 
         // General Methods
-        void exportAllLayers() const throw (Exception);
+
+        /**
+         * @brief Generate and write all Gerber and Excellon files
+         *
+         * Runs an event loop until all files are finished, so #cancel() can be called
+         * by a progress dialog while the export is running.
+         *
+         * @throw UserCanceled  If #cancel() prevented writing at least one file
+         * @throw Exception     If an output file could not be generated or written
+         */
+        void exportAllLayers() throw (Exception);
+
+        /**
+         * @brief Cancel a running export (can be called from any thread)
+         *
+         * Files which are already being generated are aborted before their next layer
+         * is drawn, and are not written at all. Files which are already being written
+         * are finished.
+         */
+        void cancel() noexcept;
 
         // Operator Overloadings
         BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 
+    signals:
+
+        /**
+         * @brief Emitted on the calling thread of #exportAllLayers() whenever a file
+         *        is finished (in the order they are finished, canceled files count too)
+         *
+         * @param finishedFiles     Count of already written files
+         * @param totalFiles        Count of all files to write
+         */
+        void progress(int finishedFiles, int totalFiles);
+
+
     private:
 
+        // Types
+        struct DrillItem {
+            Point position;
+            Length diameter;
+        };
+        struct PadItem {    ///< a footprint pad or a via
+            enum class Shape_t {Round, Rect, Octagon};
+            Point position;
+            Angle rotation;
+            Length width;
+            Length height;
+            Shape_t shape;
+            QSet<int> copperLayers;    ///< only the exported (outer) copper layers
+            bool hasStopMask;
+            Length stopMaskClearance;
+        };
+        struct TraceItem {
+            int layerId;
+            Point startPos;
+            Point endPos;
+            Length width;
+        };
+
         // Private Methods
+        void throwIfCanceled() const throw (UserCanceled);
+        void collectItems() throw (Exception);
+        void clearItems() noexcept;
+        PadItem createPadItem(const BI_FootprintPad& pad) const throw (Exception);
+        PadItem createViaItem(const BI_Via& via) const throw (Exception);
+        void exportDrillsNPTH() const throw (Exception);
         void exportDrillsPTH() const throw (Exception);
         void exportLayerBoardOutlines() const throw (Exception);
         void exportLayerTopCopper() const throw (Exception);
@@ -87,18 +151,29 @@ class BoardGerberExport final : public QObject
         void exportLayerBottomOverlay() const throw (Exception);
 
         void drawLayer(GerberGenerator& gen, int layerId) const throw (Exception);
-        void drawVia(GerberGenerator& gen, const BI_Via& via, int layerId) const throw (Exception);
-        void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, int layerId) const throw (Exception);
-        void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, int layerId) const throw (Exception);
+        void drawPad(GerberGenerator& gen, const PadItem& pad, int layerId) const throw (Exception);
 
         // Static Methods
         static Length calcWidthOfLayer(const Length& width, int layerId) noexcept;
 
 
         // Private Member Variables
-        const Project& mProject;
         const Board& mBoard;
         FilePath mOutputDirectory;
+        QAtomicInt mCancelRequested;
+
+        // Copied Items (only these are accessed by the worker threads)
+        QString mProjectName;
+        Uuid mBoardUuid;
+        QString mBoardName;
+        QList<DrillItem> mDrillsNpth;       ///< non-plated footprint holes
+        QList<DrillItem> mDrillsPth;        ///< THT pads and vias
+        QList<PadItem> mPads;
+        QList<PadItem> mVias;
+        QList<TraceItem> mTraces;
+        QList<Polygon*> mFootprintPolygons; ///< transformed to scene coordinates
+        QList<Ellipse*> mFootprintEllipses; ///< transformed to scene coordinates
+        QList<Polygon*> mBoardPolygons;
 };
 
 /*****************************************************************************************
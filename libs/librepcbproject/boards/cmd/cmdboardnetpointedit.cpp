@@ -139,6 +139,28 @@ void CmdBoardNetPointEdit::performRedo() throw (Exception)
     sgl.dismiss();
 }
 
+bool CmdBoardNetPointEdit::performCanMergeWith(const UndoCommand& other) const noexcept
+{
+    const CmdBoardNetPointEdit* cmd = dynamic_cast<const CmdBoardNetPointEdit*>(&other);
+    if ((!cmd) || (&cmd->mNetPoint != &mNetPoint)) return false;
+    if ((cmd->mOldLayer != mNewLayer) || (cmd->mOldNetSignal != mNewNetSignal)) return false;
+    if ((cmd->mOldFootprintPad != mNewFootprintPad) || (cmd->mOldVia != mNewVia)) return false;
+    if (cmd->mOldPos != mNewPos) return false;
+    return true;
+}
+
+bool CmdBoardNetPointEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdBoardNetPointEdit* cmd = dynamic_cast<const CmdBoardNetPointEdit*>(&other);
+    if ((!cmd) || (!performCanMergeWith(other))) return false;
+    mNewLayer = cmd->mNewLayer;
+    mNewNetSignal = cmd->mNewNetSignal;
+    mNewFootprintPad = cmd->mNewFootprintPad;
+    mNewVia = cmd->mNewVia;
+    mNewPos = cmd->mNewPos;
+    return true;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
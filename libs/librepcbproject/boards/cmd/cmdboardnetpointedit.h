@@ -56,6 +56,11 @@ class CmdBoardNetPointEdit final : public UndoCommand
         explicit CmdBoardNetPointEdit(BI_NetPoint& point) noexcept;
         ~CmdBoardNetPointEdit() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getMergeId()
+        int getMergeId() const noexcept override {return 1003;}
+
         // Setters
         void setLayer(BoardLayer& layer) noexcept;
         void setNetSignal(NetSignal& netsignal) noexcept;
@@ -78,6 +83,12 @@ class CmdBoardNetPointEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() throw (Exception) override;
 
+        /// @copydoc UndoCommand::performCanMergeWith()
+        bool performCanMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        bool performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
@@ -134,6 +134,28 @@ void CmdBoardViaEdit::performRedo() throw (Exception)
     mVia.setDrillDiameter(mNewDrillDiameter);
 }
 
+bool CmdBoardViaEdit::performCanMergeWith(const UndoCommand& other) const noexcept
+{
+    const CmdBoardViaEdit* cmd = dynamic_cast<const CmdBoardViaEdit*>(&other);
+    if ((!cmd) || (&cmd->mVia != &mVia)) return false;
+    if ((cmd->mOldNetSignal != mNewNetSignal) || (cmd->mOldPos != mNewPos)) return false;
+    if ((cmd->mOldShape != mNewShape) || (cmd->mOldSize != mNewSize)) return false;
+    if (cmd->mOldDrillDiameter != mNewDrillDiameter) return false;
+    return true;
+}
+
+bool CmdBoardViaEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdBoardViaEdit* cmd = dynamic_cast<const CmdBoardViaEdit*>(&other);
+    if ((!cmd) || (!performCanMergeWith(other))) return false;
+    mNewNetSignal = cmd->mNewNetSignal;
+    mNewPos = cmd->mNewPos;
+    mNewShape = cmd->mNewShape;
+    mNewSize = cmd->mNewSize;
+    mNewDrillDiameter = cmd->mNewDrillDiameter;
+    return true;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -51,6 +51,11 @@ class CmdBoardViaEdit final : public UndoCommand
         explicit CmdBoardViaEdit(BI_Via& via) noexcept;
         ~CmdBoardViaEdit() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getMergeId()
+        int getMergeId() const noexcept override {return 1002;}
+
         // Setters
         void setNetSignal(NetSignal* netsignal, bool immediate) throw (Exception);
         void setPosition(const Point& pos, bool immediate) noexcept;
@@ -73,6 +78,12 @@ class CmdBoardViaEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() throw (Exception) override;
 
+        /// @copydoc UndoCommand::performCanMergeWith()
+        bool performCanMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        bool performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
@@ -158,6 +158,25 @@ void CmdDeviceInstanceEdit::performRedo() throw (Exception)
     mDevice.setRotation(mNewRotation);
 }
 
+bool CmdDeviceInstanceEdit::performCanMergeWith(const UndoCommand& other) const noexcept
+{
+    const CmdDeviceInstanceEdit* cmd = dynamic_cast<const CmdDeviceInstanceEdit*>(&other);
+    if ((!cmd) || (&cmd->mDevice != &mDevice)) return false;
+    if ((cmd->mOldPos != mNewPos) || (cmd->mOldRotation != mNewRotation)) return false;
+    if (cmd->mOldMirrored != mNewMirrored) return false;
+    return true;
+}
+
+bool CmdDeviceInstanceEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdDeviceInstanceEdit* cmd = dynamic_cast<const CmdDeviceInstanceEdit*>(&other);
+    if ((!cmd) || (!performCanMergeWith(other))) return false;
+    mNewPos = cmd->mNewPos;
+    mNewRotation = cmd->mNewRotation;
+    mNewMirrored = cmd->mNewMirrored;
+    return true;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -50,6 +50,11 @@ class CmdDeviceInstanceEdit final : public UndoCommand
         explicit CmdDeviceInstanceEdit(BI_Device& dev) noexcept;
         ~CmdDeviceInstanceEdit() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getMergeId()
+        int getMergeId() const noexcept override {return 1001;}
+
         // General Methods
         void setPosition(Point& pos, bool immediate) noexcept;
         void setDeltaToStartPos(Point& deltaPos, bool immediate) noexcept;
@@ -72,6 +77,12 @@ class CmdDeviceInstanceEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() throw (Exception) override;
 
+        /// @copydoc UndoCommand::performCanMergeWith()
+        bool performCanMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        bool performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
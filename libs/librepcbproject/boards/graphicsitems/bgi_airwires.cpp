@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_airwires.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+#include <librepcbcommon/boardlayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_AirWires::BGI_AirWires(Board& board) noexcept :
+    GraphicsItem(), mLayer(board.getLayerStack().getBoardLayer(BoardLayer::Unrouted))
+{
+    Q_ASSERT(mLayer);
+    setZValue(Board::ItemZValue::ZValue_AirWires);
+}
+
+BGI_AirWires::~BGI_AirWires() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BGI_AirWires::setAirWires(const QList<AirWiresBuilder::AirWire>& airwires) noexcept
+{
+    prepareGeometryChange();
+    mLines.clear();
+    mBoundingRect = QRectF();
+    foreach (const AirWiresBuilder::AirWire& airwire, airwires) {
+        QLineF line(airwire.first.toPxQPointF(), airwire.second.toPxQPointF());
+        mLines.append(line);
+        mBoundingRect |= QRectF(line.p1(), line.p2()).normalized();
+    }
+    // add some margin for the (cosmetic) line width
+    mBoundingRect.adjust(-1, -1, 1, 1);
+    update();
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+void BGI_AirWires::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (mLayer->isVisible()) {
+        painter->setPen(QPen(mLayer->getColor(), 0));
+        painter->drawLines(mLines);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BGI_AIRWIRES_H
+#define LIBREPCB_PROJECT_BGI_AIRWIRES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcbcommon/graphics/graphicsitem.h>
+#include <librepcbcommon/airwiresbuilder.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class BoardLayer;
+
+namespace project {
+
+class Board;
+
+/*****************************************************************************************
+ *  Class BGI_AirWires
+ ****************************************************************************************/
+
+/**
+ * @brief The BGI_AirWires class draws all air wires of one net signal on a board
+ *
+ * All air wires of a net are drawn by a single graphics item without any shape or
+ * selection handling, so updating them is cheap even for nets with many pads. This item
+ * does not represent a board item, thus it is not derived from
+ * librepcb#project#BGI_Base.
+ */
+class BGI_AirWires final : public GraphicsItem
+{
+    public:
+
+        // Constructors / Destructor
+        explicit BGI_AirWires(Board& board) noexcept;
+        ~BGI_AirWires() noexcept;
+
+        // Setters
+        void setAirWires(const QList<AirWiresBuilder::AirWire>& airwires) noexcept;
+
+        // Inherited from QGraphicsItem
+        QRectF boundingRect() const {return mBoundingRect;}
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+
+    private:
+
+        // make some methods inaccessible...
+        BGI_AirWires() = delete;
+        BGI_AirWires(const BGI_AirWires& other) = delete;
+        BGI_AirWires& operator=(const BGI_AirWires& rhs) = delete;
+
+
+        // Attributes
+        BoardLayer* mLayer;
+
+        // Cached Attributes
+        QVector<QLineF> mLines;
+        QRectF mBoundingRect;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BGI_AIRWIRES_H
@@ -34,6 +34,8 @@
 namespace librepcb {
 namespace project {
 
+class BI_Base;
+
 /*****************************************************************************************
  *  Class BGI_Base
  ****************************************************************************************/
@@ -46,9 +48,18 @@ class BGI_Base : public GraphicsItem
     public:
 
         // Constructors / Destructor
-        explicit BGI_Base() noexcept;
+        explicit BGI_Base(BI_Base& item) noexcept;
         virtual ~BGI_Base() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the board item which is represented by this graphics item
+         *
+         * This allows to use the spatial index of the graphics scene to find board items.
+         */
+        BI_Base& getBoardItem() const noexcept {return mBoardItem;}
+
 
     protected:
 
@@ -58,9 +69,13 @@ class BGI_Base : public GraphicsItem
     private:
 
         // make some methods inaccessible...
-        //BGI_Base() = delete;
+        BGI_Base() = delete;
         BGI_Base(const BGI_Base& other) = delete;
         BGI_Base& operator=(const BGI_Base& rhs) = delete;
+
+
+        // Attributes
+        BI_Base& mBoardItem;
 };
 
 /*****************************************************************************************
@@ -48,7 +48,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_FootprintPad::BGI_FootprintPad(BI_FootprintPad& pad) noexcept :
-    BGI_Base(), mPad(pad), mLibPad(pad.getLibPad()), mPadLayer(nullptr),
+    BGI_Base(pad), mPad(pad), mLibPad(pad.getLibPad()), mPadLayer(nullptr),
     mTopStopMaskLayer(nullptr), mBottomStopMaskLayer(nullptr),
     mTopCreamMaskLayer(nullptr), mBottomCreamMaskLayer(nullptr)
 {
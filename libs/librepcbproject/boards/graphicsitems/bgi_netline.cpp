@@ -43,7 +43,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_NetLine::BGI_NetLine(BI_NetLine& netline) noexcept :
-    BGI_Base(), mNetLine(netline), mLayer(nullptr)
+    BGI_Base(netline), mNetLine(netline), mLayer(nullptr)
 {
     updateCacheAndRepaint();
 }
@@ -77,9 +77,6 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
 
     mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-    mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-    mBoundingRect.adjust(-mNetLine.getWidth().toPx()/2, -mNetLine.getWidth().toPx()/2,
-                         mNetLine.getWidth().toPx()/2, mNetLine.getWidth().toPx()/2);
     mShape = QPainterPath();
     mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
@@ -88,6 +85,9 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
     Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
     ps.setWidth(width.toPx());
     mShape = ps.createStroke(mShape);
+    // the bounding rect must contain the whole grab area (which is at least as wide as the
+    // painted line), otherwise the scene index does not find the item at all positions
+    mBoundingRect = mShape.boundingRect();
     update();
 }
 
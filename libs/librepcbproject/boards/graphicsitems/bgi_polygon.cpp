@@ -42,7 +42,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_Polygon::BGI_Polygon(BI_Polygon& polygon) noexcept :
-    BGI_Base(), mBiPolygon(polygon), mPolygon(polygon.getPolygon()), mLayer(nullptr)
+    BGI_Base(polygon), mBiPolygon(polygon), mPolygon(polygon.getPolygon()), mLayer(nullptr)
 {
     updateCacheAndRepaint();
 }
@@ -43,7 +43,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_Via::BGI_Via(BI_Via& via) noexcept :
-    BGI_Base(), mVia(via), mViaLayer(nullptr), mTopStopMaskLayer(nullptr),
+    BGI_Base(via), mVia(via), mViaLayer(nullptr), mTopStopMaskLayer(nullptr),
     mBottomStopMaskLayer(nullptr)
 {
     setZValue(Board::ZValue_Vias);
@@ -144,6 +144,7 @@ void BI_FootprintPad::addToBoard(GraphicsScene& scene) throw (Exception)
                                               [this](){mGraphicsItem->update();});
     }
     BI_Base::addToBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
 }
 
 void BI_FootprintPad::removeFromBoard(GraphicsScene& scene) throw (Exception)
@@ -158,6 +159,7 @@ void BI_FootprintPad::removeFromBoard(GraphicsScene& scene) throw (Exception)
         disconnect(mHighlightChangedConnection);
     }
     BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
 }
 
 void BI_FootprintPad::registerNetPoint(BI_NetPoint& netpoint) throw (Exception)
@@ -198,6 +200,7 @@ void BI_FootprintPad::updatePosition() noexcept
     foreach (BI_NetPoint* netpoint, mRegisteredNetPoints) {
         netpoint->setPosition(mPosition);
     }
+    if (isAddedToBoard()) mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
 }
 
 /*****************************************************************************************
@@ -34,6 +34,7 @@ namespace librepcb {
 
 namespace library {
 class FootprintPad;
+class PackagePad;
 class ComponentSignal;
 }
 
@@ -73,6 +74,7 @@ class BI_FootprintPad final : public BI_Base
         int getLayerId() const noexcept;
         bool isOnLayer(int layerId) const noexcept;
         const library::FootprintPad& getLibPad() const noexcept {return *mFootprintPad;}
+        const library::PackagePad& getLibPackagePad() const noexcept {return *mPackagePad;}
         ComponentSignalInstance* getComponentSignalInstance() const noexcept {return mComponentSignalInstance;}
         NetSignal* getCompSigInstNetSignal() const noexcept;
         bool isUsed() const noexcept {return (mRegisteredNetPoints.count() > 0);}
@@ -182,6 +182,7 @@ void BI_NetLine::addToBoard(GraphicsScene& scene) throw (Exception)
     mHighlightChangedConnection = connect(&getNetSignal(), &NetSignal::highlightedChanged,
                                           [this](){mGraphicsItem->update();});
     BI_Base::addToBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(&getNetSignal());
     sg.dismiss();
 }
 
@@ -198,6 +199,7 @@ void BI_NetLine::removeFromBoard(GraphicsScene& scene) throw (Exception)
     mEndPoint->unregisterNetLine(*this); // can throw
     disconnect(mHighlightChangedConnection);
     BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(&getNetSignal());
     sg.dismiss();
 }
 
@@ -227,6 +227,8 @@ void BI_NetPoint::setNetSignal(NetSignal& netsignal) throw (Exception)
         auto sg = scopeGuard([&](){mNetSignal->registerBoardNetPoint(*this);});
         netsignal.registerBoardNetPoint(*this); // can throw
         sg.dismiss();
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
+        mBoard.scheduleAirWiresRebuild(&netsignal);
     }
     mNetSignal = &netsignal;
 }
@@ -259,6 +261,7 @@ void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad) throw (Exception)
     }
     mFootprintPad = pad;
     mGraphicsItem->updateCacheAndRepaint();
+    if (isAddedToBoard()) mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
 void BI_NetPoint::setViaToAttach(BI_Via* via) throw (Exception)
@@ -287,6 +290,7 @@ void BI_NetPoint::setViaToAttach(BI_Via* via) throw (Exception)
     }
     mVia = via;
     mGraphicsItem->updateCacheAndRepaint();
+    if (isAddedToBoard()) mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
 void BI_NetPoint::setPosition(const Point& position) noexcept
@@ -295,6 +299,7 @@ void BI_NetPoint::setPosition(const Point& position) noexcept
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateLines();
+        if (isAddedToBoard()) mBoard.scheduleAirWiresRebuild(mNetSignal);
     }
 }
 
@@ -329,6 +334,7 @@ void BI_NetPoint::addToBoard(GraphicsScene& scene) throw (Exception)
                                           [this](){mGraphicsItem->update();});
     mErcMsgDeadNetPoint->setVisible(true);
     BI_Base::addToBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
     sgl.dismiss();
 }
 
@@ -358,6 +364,7 @@ void BI_NetPoint::removeFromBoard(GraphicsScene& scene) throw (Exception)
     disconnect(mHighlightChangedConnection);
     mErcMsgDeadNetPoint->setVisible(false);
     BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
     sgl.dismiss();
 }
 
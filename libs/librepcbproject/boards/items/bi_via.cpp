@@ -182,6 +182,8 @@ void BI_Via::setNetSignal(NetSignal* netsignal) throw (Exception)
             sgl.add([&](){netsignal->unregisterBoardVia(*this);});
         }
         sgl.dismiss();
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
+        mBoard.scheduleAirWiresRebuild(netsignal);
     }
     mNetSignal = netsignal;
     mGraphicsItem->updateCacheAndRepaint();
@@ -193,6 +195,7 @@ void BI_Via::setPosition(const Point& position) noexcept
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateNetPoints();
+        if (isAddedToBoard()) mBoard.scheduleAirWiresRebuild(mNetSignal);
     }
 }
 
@@ -235,6 +238,7 @@ void BI_Via::addToBoard(GraphicsScene& scene) throw (Exception)
                                               [this](){mGraphicsItem->update();});
     }
     BI_Base::addToBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
 void BI_Via::removeFromBoard(GraphicsScene& scene) throw (Exception)
@@ -247,6 +251,7 @@ void BI_Via::removeFromBoard(GraphicsScene& scene) throw (Exception)
         disconnect(mHighlightChangedConnection);
     }
     BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
 void BI_Via::registerNetPoint(BI_NetPoint& netpoint) throw (Exception)
@@ -387,6 +387,26 @@ bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Circuit::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // Save "core/circuit.xml"
+    try
+    {
+        QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+        doc->setFileVersion(APP_VERSION_MAJOR);
+        jobs.append(mXmlFile->prepareAutosave(doc)); // written later by the caller
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcbcommon/uuid.h>
 #include <librepcbcommon/fileio/if_xmlserializableobject.h>
 #include <librepcbcommon/exceptions.h>
@@ -112,6 +113,7 @@ class Circuit final : public QObject, public IF_XmlSerializableObject
 
         // General Methods
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
 
         // Operator Overloadings
         Circuit& operator=(const Circuit& rhs) = delete;
@@ -30,6 +30,7 @@
 #include "componentsignalinstance.h"
 #include <librepcblibrary/cmp/component.h>
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "componentattributeinstance.h"
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include "../settings/projectsettings.h"
@@ -153,7 +154,7 @@ void ComponentInstance::init() throw (Exception)
         "UnplacedRequiredSymbols", ErcMsg::ErcMsgType_t::SchematicError));
     mErcMsgUnplacedOptionalSymbols.reset(new ErcMsg(mCircuit.getProject(), *this, mUuid.toStr(),
         "UnplacedOptionalSymbols", ErcMsg::ErcMsgType_t::SchematicWarning));
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 
     // emit the "attributesChanged" signal when the project has emited it
     connect(&mCircuit.getProject(), &Project::attributesChanged, this, &ComponentInstance::attributesChanged);
@@ -247,7 +248,7 @@ void ComponentInstance::setName(const QString& name) throw (Exception)
                 tr("The new component name must not be empty!"));
         }
         mName = name;
-        updateErcMessages();
+        scheduleErcMessagesUpdate();
         emit attributesChanged();
     }
 }
@@ -312,7 +313,7 @@ void ComponentInstance::addToCircuit() throw (Exception)
         sgl.add([signal](){signal->removeFromCircuit();});
     }
     mIsAddedToCircuit = true;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     sgl.dismiss();
 }
 
@@ -332,7 +333,7 @@ void ComponentInstance::removeFromCircuit() throw (Exception)
         sgl.add([signal](){signal->addToCircuit();});
     }
     mIsAddedToCircuit = false;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     sgl.dismiss();
 }
 
@@ -351,7 +352,7 @@ void ComponentInstance::registerSymbol(SI_Symbol& symbol) throw (Exception)
             "Symbol item UUID already exists in circuit: \"%1\".")).arg(itemUuid.toStr()));
     }
     mRegisteredSymbols.insert(itemUuid, &symbol);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void ComponentInstance::unregisterSymbol(SI_Symbol& symbol) throw (Exception)
@@ -363,7 +364,7 @@ void ComponentInstance::unregisterSymbol(SI_Symbol& symbol) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredSymbols.remove(itemUuid);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void ComponentInstance::registerDevice(BI_Device& device) throw (Exception)
@@ -374,7 +375,7 @@ void ComponentInstance::registerDevice(BI_Device& device) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredDevices.append(&device);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void ComponentInstance::unregisterDevice(BI_Device& device) throw (Exception)
@@ -383,7 +384,7 @@ void ComponentInstance::unregisterDevice(BI_Device& device) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredDevices.removeOne(&device);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 XmlDomElement* ComponentInstance::serializeToXmlDomElement() const throw (Exception)
@@ -440,6 +441,11 @@ bool ComponentInstance::checkAttributesValidity() const noexcept
     return true;
 }
 
+void ComponentInstance::scheduleErcMessagesUpdate() noexcept
+{
+    mCircuit.getProject().getErcMsgList().scheduleUpdate(*this, [this](){updateErcMessages();});
+}
+
 void ComponentInstance::updateErcMessages() noexcept
 {
     int required = getUnplacedRequiredSymbolsCount();
@@ -158,6 +158,7 @@ class ComponentInstance : public QObject, public IF_AttributeProvider,
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
 
+        void scheduleErcMessagesUpdate() noexcept;
         void updateErcMessages() noexcept;
 
 
@@ -34,6 +34,7 @@
 #include "../settings/projectsettings.h"
 #include "../schematics/items/si_symbolpin.h"
 #include "../boards/items/bi_footprintpad.h"
+#include "../boards/board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -182,6 +183,11 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal) throw (Exceptio
                       disconnect(netsignal, &NetSignal::nameChanged,
                       this, &ComponentSignalInstance::netSignalNameChanged);});
     }
+    // the air wires of the pads are affected by the net signal change
+    foreach (BI_FootprintPad* pad, mRegisteredFootprintPads) {
+        pad->getBoard().scheduleAirWiresRebuild(mNetSignal);
+        pad->getBoard().scheduleAirWiresRebuild(netsignal);
+    }
     mNetSignal = netsignal;
     updateErcMessages();
     sgl.dismiss();
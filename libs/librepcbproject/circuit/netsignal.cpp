@@ -25,7 +25,9 @@
 #include "netclass.h"
 #include <librepcbcommon/exceptions.h>
 #include "circuit.h"
+#include "../project.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "componentsignalinstance.h"
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include "../schematics/items/si_netlabel.h"
@@ -119,7 +121,7 @@ void NetSignal::setName(const QString& name, bool isAutoName) throw (Exception)
     }
     mName = name;
     mHasAutoName = isAutoName;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit nameChanged(mName);
 }
 
@@ -142,7 +144,7 @@ void NetSignal::addToCircuit() throw (Exception)
     }
     mNetClass->registerNetSignal(*this); // can throw
     mIsAddedToCircuit = true;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::removeFromCircuit() throw (Exception)
@@ -157,7 +159,7 @@ void NetSignal::removeFromCircuit() throw (Exception)
     }
     mNetClass->unregisterNetSignal(*this); // can throw
     mIsAddedToCircuit = false;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerComponentSignal(ComponentSignalInstance& signal) throw (Exception)
@@ -168,7 +170,7 @@ void NetSignal::registerComponentSignal(ComponentSignalInstance& signal) throw (
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredComponentSignals.append(&signal);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterComponentSignal(ComponentSignalInstance& signal) throw (Exception)
@@ -177,7 +179,7 @@ void NetSignal::unregisterComponentSignal(ComponentSignalInstance& signal) throw
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredComponentSignals.removeOne(&signal);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerSchematicNetPoint(SI_NetPoint& netpoint) throw (Exception)
@@ -188,7 +190,7 @@ void NetSignal::registerSchematicNetPoint(SI_NetPoint& netpoint) throw (Exceptio
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredSchematicNetPoints.append(&netpoint);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterSchematicNetPoint(SI_NetPoint& netpoint) throw (Exception)
@@ -197,7 +199,7 @@ void NetSignal::unregisterSchematicNetPoint(SI_NetPoint& netpoint) throw (Except
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredSchematicNetPoints.removeOne(&netpoint);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerSchematicNetLabel(SI_NetLabel& netlabel) throw (Exception)
@@ -208,7 +210,7 @@ void NetSignal::registerSchematicNetLabel(SI_NetLabel& netlabel) throw (Exceptio
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredSchematicNetLabels.append(&netlabel);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterSchematicNetLabel(SI_NetLabel& netlabel) throw (Exception)
@@ -217,7 +219,7 @@ void NetSignal::unregisterSchematicNetLabel(SI_NetLabel& netlabel) throw (Except
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredSchematicNetLabels.removeOne(&netlabel);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerBoardNetPoint(BI_NetPoint& netpoint) throw (Exception)
@@ -228,7 +230,7 @@ void NetSignal::registerBoardNetPoint(BI_NetPoint& netpoint) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredBoardNetPoints.append(&netpoint);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterBoardNetPoint(BI_NetPoint& netpoint) throw (Exception)
@@ -237,7 +239,7 @@ void NetSignal::unregisterBoardNetPoint(BI_NetPoint& netpoint) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredBoardNetPoints.removeOne(&netpoint);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerBoardVia(BI_Via& via) throw (Exception)
@@ -248,7 +250,7 @@ void NetSignal::registerBoardVia(BI_Via& via) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredBoardVias.append(&via);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterBoardVia(BI_Via& via) throw (Exception)
@@ -257,7 +259,7 @@ void NetSignal::unregisterBoardVia(BI_Via& via) throw (Exception)
         throw LogicError(__FILE__, __LINE__);
     }
     mRegisteredBoardVias.removeOne(&via);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
 }
 
 XmlDomElement* NetSignal::serializeToXmlDomElement() const throw (Exception)
@@ -284,6 +286,11 @@ bool NetSignal::checkAttributesValidity() const noexcept
     return true;
 }
 
+void NetSignal::scheduleErcMessagesUpdate() noexcept
+{
+    mCircuit.getProject().getErcMsgList().scheduleUpdate(*this, [this](){updateErcMessages();});
+}
+
 void NetSignal::updateErcMessages() noexcept
 {
     if (mIsAddedToCircuit && (!isUsed())) {
@@ -120,6 +120,7 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public IF_XmlS
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
 
+        void scheduleErcMessagesUpdate() noexcept;
         void updateErcMessages() noexcept;
 
 
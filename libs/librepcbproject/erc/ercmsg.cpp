@@ -62,13 +62,21 @@ void ErcMsg::setMsg(const QString& msg) noexcept
 void ErcMsg::setVisible(bool visible) noexcept
 {
     if (visible == mIsVisible) return;
-    mIsVisible = visible;
-    mIsIgnored = false; // changing the visibility will always reset the ignore flag!
 
-    if (mIsVisible)
+    if (visible)
+    {
+        // messages which were ignored before (in the last session, or before the message
+        // was recreated, e.g. by a design rule check) are ignored again
+        mIsVisible = true;
+        mIsIgnored = mErcMsgList.isIgnored(*this);
         mErcMsgList.add(this);
+    }
     else
+    {
+        setIgnored(false); // hiding a message will always reset the ignore flag!
+        mIsVisible = false;
         mErcMsgList.remove(this);
+    }
 }
 
 void ErcMsg::setIgnored(bool ignored) noexcept
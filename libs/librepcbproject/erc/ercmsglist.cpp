@@ -20,6 +20,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <algorithm>
 #include <QtCore>
 #include "ercmsglist.h"
 #include "ercmsg.h"
@@ -48,6 +49,16 @@ ErcMsgList::ErcMsgList(Project& project, bool restore, bool readOnly, bool creat
         mXmlFile.reset(SmartXmlFile::create(mXmlFilepath));
     } else {
         mXmlFile.reset(new SmartXmlFile(mXmlFilepath, restore, readOnly));
+
+        // load the ignore list, it is applied to the messages as soon as they are added
+        QSharedPointer<XmlDomDocument> doc = mXmlFile->parseFileAndBuildDomTree(true);
+        for (XmlDomElement* node = doc->getRoot().getFirstChild("ignore/item", true, false);
+             node; node = node->getNextSibling("item"))
+        {
+            mIgnoredKeys.insert(ignoreKey(node->getAttribute<QString>("owner_class", false),
+                                          node->getAttribute<QString>("owner_key", false),
+                                          node->getAttribute<QString>("msg_key", false)));
+        }
     }
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -66,8 +77,8 @@ void ErcMsgList::add(ErcMsg* ercMsg) noexcept
 {
     Q_ASSERT(ercMsg);
     Q_ASSERT(!mItems.contains(ercMsg));
-    Q_ASSERT(!ercMsg->isIgnored());
-    mItems.append(ercMsg);
+    Q_ASSERT(ercMsg->isIgnored() == isIgnored(*ercMsg));
+    mItems.insert(ercMsg);
     emit ercMsgAdded(ercMsg);
 }
 
@@ -76,7 +87,7 @@ void ErcMsgList::remove(ErcMsg* ercMsg) noexcept
     Q_ASSERT(ercMsg);
     Q_ASSERT(mItems.contains(ercMsg));
     Q_ASSERT(!ercMsg->isIgnored());
-    mItems.removeOne(ercMsg);
+    mItems.remove(ercMsg);
     emit ercMsgRemoved(ercMsg);
 }
 
@@ -85,46 +96,52 @@ void ErcMsgList::update(ErcMsg* ercMsg) noexcept
     Q_ASSERT(ercMsg);
     Q_ASSERT(mItems.contains(ercMsg));
     Q_ASSERT(ercMsg->isVisible());
+    if (ercMsg->isIgnored())
+        mIgnoredKeys.insert(ignoreKey(*ercMsg));
+    else
+        mIgnoredKeys.remove(ignoreKey(*ercMsg));
     emit ercMsgChanged(ercMsg);
 }
 
-void ErcMsgList::restoreIgnoreState() noexcept
+bool ErcMsgList::isIgnored(const ErcMsg& ercMsg) const noexcept
 {
-    if (mXmlFile->isCreated()) return; // the XML file does not yet exist
+    return mIgnoredKeys.contains(ignoreKey(ercMsg));
+}
 
-    QSharedPointer<XmlDomDocument> doc = mXmlFile->parseFileAndBuildDomTree(true);
-    XmlDomElement& root = doc->getRoot();
+bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
+{
+    bool success = true;
 
-    // reset all ignore attributes
-    foreach (ErcMsg* ercMsg, mItems)
-        ercMsg->setIgnored(false);
+    processScheduledUpdates(); // make sure all ERC messages are up to date
 
-    // scan ignored items and set ignore attributes
-    for (XmlDomElement* node = root.getFirstChild("ignore/item", true, false);
-         node; node = node->getNextSibling("item"))
+    // Save "core/erc.xml"
+    try
     {
-        foreach (ErcMsg* ercMsg, mItems)
-        {
-            if ((ercMsg->getOwner().getErcMsgOwnerClassName() == node->getAttribute<QString>("owner_class", false))
-             && (ercMsg->getOwnerKey() == node->getAttribute<QString>("owner_key", false))
-             && (ercMsg->getMsgKey() == node->getAttribute<QString>("msg_key", false)))
-            {
-                ercMsg->setIgnored(true);
-            }
-        }
+        XmlDomDocument doc(*serializeToXmlDomElement());
+        doc.setFileVersion(APP_VERSION_MAJOR);
+        mXmlFile->save(doc, toOriginal);
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
     }
+
+    return success;
 }
 
-bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
+bool ErcMsgList::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
 {
     bool success = true;
 
+    processScheduledUpdates(); // make sure all ERC messages are up to date
+
     // Save "core/erc.xml"
     try
     {
-        XmlDomDocument doc(*serializeToXmlDomElement());
-        doc.setFileVersion(APP_VERSION_MAJOR);
-        mXmlFile->save(doc, toOriginal);
+        QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+        doc->setFileVersion(APP_VERSION_MAJOR);
+        jobs.append(mXmlFile->prepareAutosave(doc)); // written later by the caller
     }
     catch (Exception& e)
     {
@@ -135,30 +152,81 @@ bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+void ErcMsgList::scheduleUpdate(QObject& owner, const std::function<void()>& update) noexcept
+{
+    if (mScheduledUpdates.contains(&owner)) return; // already scheduled
+
+    if (mScheduledUpdates.isEmpty()) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+        QTimer::singleShot(0, this, &ErcMsgList::processScheduledUpdates);
+#else
+        QTimer::singleShot(0, this, SLOT(processScheduledUpdates()));
+#endif
+    }
+    connect(&owner, &QObject::destroyed, this, &ErcMsgList::scheduledUpdateOwnerDestroyed,
+            Qt::UniqueConnection);
+    mScheduledUpdateOwners.append(&owner);
+    mScheduledUpdates.insert(&owner, update);
+}
+
+void ErcMsgList::processScheduledUpdates() noexcept
+{
+    // updates may schedule other updates, so take them one by one
+    while (!mScheduledUpdateOwners.isEmpty()) {
+        QObject* owner = mScheduledUpdateOwners.takeFirst();
+        std::function<void()> update = mScheduledUpdates.take(owner);
+        update();
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void ErcMsgList::scheduledUpdateOwnerDestroyed(QObject* owner) noexcept
+{
+    if (mScheduledUpdates.remove(owner) > 0) {
+        mScheduledUpdateOwners.removeOne(owner);
+    }
+}
+
 bool ErcMsgList::checkAttributesValidity() const noexcept
 {
     return true;
 }
 
+QString ErcMsgList::ignoreKey(const QString& ownerClass, const QString& ownerKey,
+                              const QString& msgKey) noexcept
+{
+    // tabs are never used in these keys, so they are safe as separator
+    return ownerClass % '\t' % ownerKey % '\t' % msgKey;
+}
+
+QString ErcMsgList::ignoreKey(const ErcMsg& ercMsg) noexcept
+{
+    return ignoreKey(ercMsg.getOwner().getErcMsgOwnerClassName(), ercMsg.getOwnerKey(),
+                     ercMsg.getMsgKey());
+}
+
 XmlDomElement* ErcMsgList::serializeToXmlDomElement() const throw (Exception)
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
     QScopedPointer<XmlDomElement> root(new XmlDomElement("erc"));
     XmlDomElement* ignoreNode = root->appendChild("ignore");
-    foreach (ErcMsg* ercMsg, mItems)
+    // messages which do not exist at the moment (e.g. design rule violations before the
+    // design rule check was executed) are kept in the ignore list too, and the keys are
+    // sorted to get a stable file content (mIgnoredKeys is not ordered)
+    QStringList ignoredKeys = mIgnoredKeys.toList();
+    std::sort(ignoredKeys.begin(), ignoredKeys.end());
+    foreach (const QString& key, ignoredKeys)
     {
-        if (ercMsg->isIgnored())
-        {
-            XmlDomElement* itemNode = ignoreNode->appendChild("item");
-            itemNode->setAttribute("owner_class", ercMsg->getOwner().getErcMsgOwnerClassName());
-            itemNode->setAttribute("owner_key", ercMsg->getOwnerKey());
-            itemNode->setAttribute("msg_key", ercMsg->getMsgKey());
-        }
+        QStringList parts = key.split('\t');
+        Q_ASSERT(parts.count() == 3);
+        XmlDomElement* itemNode = ignoreNode->appendChild("item");
+        itemNode->setAttribute("owner_class", parts.value(0));
+        itemNode->setAttribute("owner_key", parts.value(1));
+        itemNode->setAttribute("msg_key", parts.value(2));
     }
     return root.take();
 }
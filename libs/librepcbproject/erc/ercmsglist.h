@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcbcommon/fileio/if_xmlserializableobject.h>
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/fileio/filepath.h>
@@ -60,19 +61,59 @@ class ErcMsgList final : public QObject, public IF_XmlSerializableObject
         ~ErcMsgList() noexcept;
 
         // Getters
-        const QList<ErcMsg*>& getItems() const noexcept {return mItems;}
+        const QSet<ErcMsg*>& getItems() const noexcept {return mItems;}
 
         // General Methods
         void add(ErcMsg* ercMsg) noexcept;
         void remove(ErcMsg* ercMsg) noexcept;
         void update(ErcMsg* ercMsg) noexcept;
-        void restoreIgnoreState() noexcept;
+
+        /**
+         * @brief Check whether a message is ignored in the ignore list of the project
+         *
+         * The ignore list contains the ignored messages of the last saved session and all
+         * messages ignored since then, as long as they are visible. This allows to restore
+         * the ignore state of messages which are created at any time, e.g. by a design rule
+         * check, and not only of the messages which exist when the project is opened.
+         *
+         * @param ercMsg    The message to check (does not need to be visible)
+         *
+         * @return True if a message with the same owner and keys is ignored
+         */
+        bool isIgnored(const ErcMsg& ercMsg) const noexcept;
+
         bool save(bool toOriginal, QStringList& errors) noexcept;
-        
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
+
+        /**
+         * @brief Schedule a deferred update of the ERC messages of an object
+         *
+         * Updating ERC messages can be expensive (e.g. a board checks all component
+         * instances), so objects should not update them on every change. Instead, the
+         * update function is called once in the next event loop iteration, no matter
+         * how often it was scheduled until then. Pending updates of destroyed objects are
+         * discarded.
+         *
+         * @param owner     The object whose ERC messages need to be updated
+         * @param update    The function which updates the ERC messages of "owner"
+         */
+        void scheduleUpdate(QObject& owner, const std::function<void()>& update) noexcept;
+
         // Operator Overloadings
         ErcMsgList& operator=(const ErcMsgList& rhs) = delete;
 
 
+    public slots:
+
+        /**
+         * @brief Immediately execute all updates scheduled with #scheduleUpdate()
+         *
+         * This is called automatically in the event loop, and before the ERC messages
+         * are saved.
+         */
+        void processScheduledUpdates() noexcept;
+
+
     signals:
 
         void ercMsgAdded(ErcMsg* ercMsg);
@@ -83,6 +124,10 @@ class ErcMsgList final : public QObject, public IF_XmlSerializableObject
     private:
 
         // Private Methods
+        void scheduledUpdateOwnerDestroyed(QObject* owner) noexcept;
+        static QString ignoreKey(const QString& ownerClass, const QString& ownerKey,
+                                 const QString& msgKey) noexcept;
+        static QString ignoreKey(const ErcMsg& ercMsg) noexcept;
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
@@ -99,7 +144,10 @@ class ErcMsgList final : public QObject, public IF_XmlSerializableObject
         QScopedPointer<SmartXmlFile> mXmlFile;
 
         // Misc
-        QList<ErcMsg*> mItems; ///< contains all visible ERC messages
+        QSet<ErcMsg*> mItems; ///< contains all visible ERC messages
+        QSet<QString> mIgnoredKeys; ///< keys of all ignored messages, see #isIgnored()
+        QList<QObject*> mScheduledUpdateOwners; ///< owners of #mScheduledUpdates, in order
+        QHash<QObject*, std::function<void()>> mScheduledUpdates; ///< see #scheduleUpdate()
 };
 
 /*****************************************************************************************
@@ -13,7 +13,7 @@ GENERATED_DIR = ../../generated
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets xml sql printsupport
+QT += core widgets xml sql printsupport concurrent
 
 CONFIG += staticlib
 
@@ -94,6 +94,7 @@ SOURCES += \
     boards/items/bi_netline.cpp \
     boards/graphicsitems/bgi_netpoint.cpp \
     boards/graphicsitems/bgi_netline.cpp \
+    boards/graphicsitems/bgi_airwires.cpp \
     boards/cmd/cmdboardnetlineadd.cpp \
     boards/cmd/cmdboardnetlineremove.cpp \
     boards/cmd/cmdboardnetpointadd.cpp \
@@ -105,7 +106,8 @@ SOURCES += \
     boards/cmd/cmdboardviaremove.cpp \
     boards/cmd/cmdboardviaedit.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
-    boards/boardgerberexport.cpp
+    boards/boardgerberexport.cpp \
+    boards/boarddesignrulecheck.cpp
 
 HEADERS += \
     project.h \
@@ -182,6 +184,7 @@ HEADERS += \
     boards/items/bi_netline.h \
     boards/graphicsitems/bgi_netpoint.h \
     boards/graphicsitems/bgi_netline.h \
+    boards/graphicsitems/bgi_airwires.h \
     boards/cmd/cmdboardnetlineadd.h \
     boards/cmd/cmdboardnetlineremove.h \
     boards/cmd/cmdboardnetpointadd.h \
@@ -193,6 +196,7 @@ HEADERS += \
     boards/cmd/cmdboardviaremove.h \
     boards/cmd/cmdboardviaedit.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
-    boards/boardgerberexport.h
+    boards/boardgerberexport.h \
+    boards/boarddesignrulecheck.h
 
 FORMS +=
@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtConcurrent>
 #include <QPrinter>
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/fileio/filelock.h>
@@ -208,11 +209,16 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) throw (Ex
         }
         else
         {
+            QList<FilePath> filepaths;
             for (XmlDomElement* node = root->getFirstChild("schematics/schematic", true, false);
                  node; node = node->getNextSibling("schematic"))
             {
-                FilePath fp = FilePath::fromRelative(mPath.getPathTo("schematics"), node->getText<QString>(true));
-                Schematic* schematic = new Schematic(*this, fp, mIsRestored, mIsReadOnly);
+                filepaths.append(FilePath::fromRelative(mPath.getPathTo("schematics"), node->getText<QString>(true)));
+            }
+            QList<QSharedPointer<XmlDomDocument>> docs = parseXmlFiles(filepaths, mIsRestored);
+            for (int i = 0; i < filepaths.count(); ++i)
+            {
+                Schematic* schematic = new Schematic(*this, filepaths.at(i), mIsRestored, mIsReadOnly, docs.at(i));
                 addSchematic(*schematic);
             }
             qDebug() << mSchematics.count() << "schematics successfully loaded!";
@@ -227,21 +233,21 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) throw (Ex
         }
         else
         {
+            QList<FilePath> filepaths;
             for (XmlDomElement* node = root->getFirstChild("boards/board", true, false);
                  node; node = node->getNextSibling("board"))
             {
-                FilePath fp = FilePath::fromRelative(mPath.getPathTo("boards"), node->getText<QString>(true));
-                Board* board = new Board(*this, fp, mIsRestored, mIsReadOnly);
+                filepaths.append(FilePath::fromRelative(mPath.getPathTo("boards"), node->getText<QString>(true)));
+            }
+            QList<QSharedPointer<XmlDomDocument>> docs = parseXmlFiles(filepaths, mIsRestored);
+            for (int i = 0; i < filepaths.count(); ++i)
+            {
+                Board* board = new Board(*this, filepaths.at(i), mIsRestored, mIsReadOnly, docs.at(i));
                 addBoard(*board);
             }
             qDebug() << mBoards.count() << "boards successfully loaded!";
         }
 
-        // at this point, the whole circuit with all schematics and boards is successfully
-        // loaded, so the ERC list now contains all the correct ERC messages.
-        // So we can now restore the ignore state of each ERC message from the XML file.
-        mErcMsgList->restoreIgnoreState();
-
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
         if (create) save(true); // write all files to harddisc
@@ -550,6 +556,37 @@ void Project::save(bool toOriginal) throw (Exception)
     Q_ASSERT(errors.isEmpty());
 }
 
+std::function<void()> Project::prepareAutosave() throw (Exception)
+{
+    QStringList errors;
+    QList<std::function<void()>> jobs;
+
+    if (!prepareAutosave(jobs, errors))
+    {
+        QString msg = QString(tr("The project could not be saved!\n\nError Message:\n%1",
+            "variable count of error messages", errors.count())).arg(errors.join("\n"));
+        throw RuntimeError(__FILE__, __LINE__, QString(), msg);
+    }
+    Q_ASSERT(errors.isEmpty());
+
+    return [jobs]() {
+        // write all files, even if some of them fail, and rethrow the first error
+        QScopedPointer<Exception> error;
+        foreach (const std::function<void()>& job, jobs)
+        {
+            try
+            {
+                job();
+            }
+            catch (Exception& e)
+            {
+                if (!error) error.reset(e.clone());
+            }
+        }
+        if (error) error->raise();
+    };
+}
+
 /*****************************************************************************************
  *  Helper Methods
  ****************************************************************************************/
@@ -686,6 +723,64 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Project::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
+{
+    bool success = true;
+
+    if (mIsReadOnly)
+    {
+        errors.append(tr("The project was opened in read-only mode."));
+        return false;
+    }
+
+    // Snapshot of the *.lpp project file
+    try
+    {
+        setLastModified(QDateTime::currentDateTime());
+        QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+        doc->setFileVersion(APP_VERSION_MAJOR);
+        jobs.append(mXmlFile->prepareAutosave(doc));
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
+    }
+
+    // Snapshot of the circuit
+    if (!mCircuit->prepareAutosave(jobs, errors))
+        success = false;
+
+    // Snapshots of all removed and added schematics (*.xml files)
+    foreach (Schematic* schematic, mRemovedSchematics + mSchematics)
+    {
+        if (!schematic->prepareAutosave(jobs, errors))
+            success = false;
+    }
+
+    // Snapshots of all removed and added boards (*.xml files)
+    foreach (Board* board, mRemovedBoards + mBoards)
+    {
+        if (!board->prepareAutosave(jobs, errors))
+            success = false;
+    }
+
+    // Save library (this only moves added elements into the project, the element files
+    // are not modified by the project, so this is done immediately)
+    if (!mProjectLibrary->save(false, errors))
+        success = false;
+
+    // Snapshot of the settings
+    if (!mProjectSettings->prepareAutosave(jobs, errors))
+        success = false;
+
+    // Snapshot of the ERC messages list
+    if (!mErcMsgList->prepareAutosave(jobs, errors))
+        success = false;
+
+    return success;
+}
+
 void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) throw (Exception)
 {
     if (pages.isEmpty())
@@ -715,6 +810,43 @@ void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) throw (E
     }
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QList<QSharedPointer<XmlDomDocument>> Project::parseXmlFiles(const QList<FilePath>& filepaths,
+                                                             bool restore) throw (Exception)
+{
+    QList<QFuture<QSharedPointer<XmlDomDocument>>> futures;
+    foreach (const FilePath& filepath, filepaths)
+    {
+        futures.append(QtConcurrent::run([filepath, restore]() {
+            // open read-only as the file is only parsed here (the schematic/board will
+            // open the file again to be able to save it)
+            SmartXmlFile file(filepath, restore, true);
+            return file.parseFileAndBuildDomTree(true);
+        }));
+    }
+
+    QList<QSharedPointer<XmlDomDocument>> docs;
+    for (int i = 0; i < futures.count(); ++i)
+    {
+        try
+        {
+            docs.append(futures[i].result()); // rethrows exceptions of the worker thread
+        }
+        catch (...)
+        {
+            // don't leave any workers running in the background (e.g. still holding
+            // file handles while the caller cleans up)
+            foreach (QFuture<QSharedPointer<XmlDomDocument>> future, futures)
+                try { future.waitForFinished(); } catch (...) {}
+            throw;
+        }
+    }
+    return docs;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
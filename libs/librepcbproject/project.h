@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcbcommon/fileio/if_xmlserializableobject.h>
 #include <librepcbcommon/if_attributeprovider.h>
 #include <librepcbcommon/if_schematiclayerprovider.h>
@@ -41,6 +42,7 @@ namespace librepcb {
 
 class SmartTextFile;
 class SmartXmlFile;
+class XmlDomDocument;
 
 namespace project {
 
@@ -433,6 +435,22 @@ class Project final : public QObject, public IF_AttributeProvider,
          */
         void save(bool toOriginal) throw (Exception);
 
+        /**
+         * @brief Prepare an automatic backup of the whole project (to temporary files)
+         *
+         * Only a snapshot of the XML DOM trees is taken here, which is much faster than
+         * #save(). Formatting the XML trees and writing the files is done by the
+         * returned function, which does not access the project anymore and thus can be
+         * executed in a worker thread while the project is modified.
+         *
+         * @return A function which writes all temporary files (throws on error)
+         *
+         * @note The whole save procedere is described in @ref doc_project_save.
+         *
+         * @throw Exception on error
+         */
+        std::function<void()> prepareAutosave() throw (Exception);
+
 
         // Helper Methods
 
@@ -523,6 +541,17 @@ class Project final : public QObject, public IF_AttributeProvider,
          */
         bool save(bool toOriginal, QStringList& errors) noexcept;
 
+        /**
+         * @brief Take a snapshot of the project for an autosave (see #prepareAutosave())
+         *
+         * @param jobs          The functions which write the snapshot to the temporary
+         *                      files will be added to this list
+         * @param errors        All errors will be added to this string list (translated)
+         *
+         * @return True on success (then the error list should be empty), false otherwise
+         */
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
+
         /**
          * @brief Print some schematics to a QPrinter (printer or file)
          *
@@ -533,6 +562,25 @@ class Project final : public QObject, public IF_AttributeProvider,
          */
         void printSchematicPages(QPrinter& printer, QList<int>& pages) throw (Exception);
 
+        /**
+         * @brief Parse multiple XML files concurrently in worker threads
+         *
+         * This is used to load all schematics and boards faster. Only the XML parsing is
+         * done in worker threads, the schematic and board objects have to be created in
+         * the main thread afterwards.
+         *
+         * @param filepaths     The files to parse
+         * @param restore       If true, the backup files (*.*~) are parsed if they exist
+         *
+         * @return The parsed files, in the same order as "filepaths"
+         *
+         * @throw Exception     If at least one file could not be parsed (the exception
+         *                      of the first such file is rethrown after all worker
+         *                      threads are finished)
+         */
+        static QList<QSharedPointer<XmlDomDocument>> parseXmlFiles(const QList<FilePath>& filepaths,
+                                                                   bool restore) throw (Exception);
+
 
         // Project File (*.lpp)
         FilePath mPath; ///< the path to the project directory
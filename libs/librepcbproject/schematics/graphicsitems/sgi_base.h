@@ -34,6 +34,8 @@
 namespace librepcb {
 namespace project {
 
+class SI_Base;
+
 /*****************************************************************************************
  *  Class SGI_Base
  ****************************************************************************************/
@@ -46,16 +48,29 @@ class SGI_Base : public GraphicsItem
     public:
 
         // Constructors / Destructor
-        explicit SGI_Base() noexcept;
+        explicit SGI_Base(SI_Base& item) noexcept;
         virtual ~SGI_Base() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the schematic item which is represented by this graphics item
+         *
+         * This allows to use the spatial index of the graphics scene to find schematic items.
+         */
+        SI_Base& getSchematicItem() const noexcept {return mSchematicItem;}
+
 
     private:
 
         // make some methods inaccessible...
-        //SGI_Base() = delete;
+        SGI_Base() = delete;
         SGI_Base(const SGI_Base& other) = delete;
         SGI_Base& operator=(const SGI_Base& rhs) = delete;
+
+
+        // Attributes
+        SI_Base& mSchematicItem;
 };
 
 /*****************************************************************************************
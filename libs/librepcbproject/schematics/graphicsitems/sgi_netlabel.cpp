@@ -43,7 +43,7 @@ QVector<QLineF> SGI_NetLabel::sOriginCrossLines;
  ****************************************************************************************/
 
 SGI_NetLabel::SGI_NetLabel(SI_NetLabel& netlabel) noexcept :
-    SGI_Base(), mNetLabel(netlabel)
+    SGI_Base(netlabel), mNetLabel(netlabel)
 {
     setZValue(Schematic::ZValue_NetLabels);
 
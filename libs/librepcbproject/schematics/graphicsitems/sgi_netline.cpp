@@ -42,7 +42,7 @@ namespace project {
  ****************************************************************************************/
 
 SGI_NetLine::SGI_NetLine(SI_NetLine& netline) noexcept :
-    SGI_Base(), mNetLine(netline), mLayer(nullptr)
+    SGI_Base(netline), mNetLine(netline), mLayer(nullptr)
 {
     setZValue(Schematic::ZValue_NetLines);
 
@@ -65,9 +65,6 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept
     prepareGeometryChange();
     mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-    mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-    mBoundingRect.adjust(-mNetLine.getWidth().toPx()/2, -mNetLine.getWidth().toPx()/2,
-                         mNetLine.getWidth().toPx()/2, mNetLine.getWidth().toPx()/2);
     mShape = QPainterPath();
     mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
@@ -76,6 +73,7 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept
     Length width = (mNetLine.getWidth() > Length(1270000) ? mNetLine.getWidth() : Length(1270000));
     ps.setWidth(width.toPx());
     mShape = ps.createStroke(mShape);
+    mBoundingRect = mShape.boundingRect(); // the scene index must find the whole grab area
     update();
 }
 
@@ -43,7 +43,7 @@ QRectF SGI_NetPoint::sBoundingRect;
  ****************************************************************************************/
 
 SGI_NetPoint::SGI_NetPoint(SI_NetPoint& netpoint) noexcept :
-    SGI_Base(), mNetPoint(netpoint), mLayer(nullptr)
+    SGI_Base(netpoint), mNetPoint(netpoint), mLayer(nullptr)
 {
     setZValue(Schematic::ZValue_VisibleNetPoints);
 
@@ -43,7 +43,7 @@ namespace project {
  ****************************************************************************************/
 
 SGI_Symbol::SGI_Symbol(SI_Symbol& symbol) noexcept :
-    SGI_Base(), mSymbol(symbol), mLibSymbol(symbol.getLibSymbol())
+    SGI_Base(symbol), mSymbol(symbol), mLibSymbol(symbol.getLibSymbol())
 {
     setZValue(Schematic::ZValue_Symbols);
 
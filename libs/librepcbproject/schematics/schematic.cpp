@@ -33,6 +33,7 @@
 #include "items/si_netpoint.h"
 #include "items/si_netline.h"
 #include "items/si_netlabel.h"
+#include "graphicsitems/sgi_base.h"
 #include <librepcbcommon/graphics/graphicsview.h>
 #include <librepcbcommon/graphics/graphicsscene.h>
 #include <librepcbcommon/gridproperties.h>
@@ -49,7 +50,8 @@ namespace project {
  ****************************************************************************************/
 
 Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
-                     bool readOnly, bool create, const QString& newName) throw (Exception):
+                     bool readOnly, bool create, const QString& newName,
+                     const QSharedPointer<XmlDomDocument>& parsedDoc) throw (Exception):
     QObject(&project), IF_AttributeProvider(), mProject(project), mFilePath(filepath),
     mIsAddedToProject(false)
 {
@@ -72,7 +74,8 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
         else
         {
             mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
-            QSharedPointer<XmlDomDocument> doc = mXmlFile->parseFileAndBuildDomTree(true);
+            QSharedPointer<XmlDomDocument> doc = parsedDoc;
+            if (!doc) doc = mXmlFile->parseFileAndBuildDomTree(true);
             XmlDomElement& root = doc->getRoot();
 
             // the schematic seems to be ready to open, so we will create all needed objects
@@ -94,6 +97,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
                         .arg(symbol->getUuid().toStr()));
                 }
                 mSymbols.append(symbol);
+                mSymbolsByUuid.insert(symbol->getUuid(), symbol);
             }
 
             // Load all netpoints
@@ -107,6 +111,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
                         .arg(netpoint->getUuid().toStr()));
                 }
                 mNetPoints.append(netpoint);
+                mNetPointsByUuid.insert(netpoint->getUuid(), netpoint);
             }
 
             // Load all netlines
@@ -120,6 +125,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
                         .arg(netline->getUuid().toStr()));
                 }
                 mNetLines.append(netline);
+                mNetLinesByUuid.insert(netline->getUuid(), netline);
             }
 
             // Load all netlabels
@@ -133,6 +139,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
                         .arg(netlabel->getUuid().toStr()));
                 }
                 mNetLabels.append(netlabel);
+                mNetLabelsByUuid.insert(netlabel->getUuid(), netlabel);
             }
         }
 
@@ -144,9 +151,13 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        mNetLabelsByUuid.clear();
         qDeleteAll(mNetLabels);         mNetLabels.clear();
+        mNetLinesByUuid.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
+        mNetPointsByUuid.clear();
         qDeleteAll(mNetPoints);         mNetPoints.clear();
+        mSymbolsByUuid.clear();
         qDeleteAll(mSymbols);           mSymbols.clear();
         mGridProperties.reset();
         mXmlFile.reset();
@@ -160,9 +171,13 @@ Schematic::~Schematic() noexcept
     Q_ASSERT(!mIsAddedToProject);
 
     // delete all items
+    mNetLabelsByUuid.clear();
     qDeleteAll(mNetLabels);         mNetLabels.clear();
+    mNetLinesByUuid.clear();
     qDeleteAll(mNetLines);          mNetLines.clear();
+    mNetPointsByUuid.clear();
     qDeleteAll(mNetPoints);         mNetPoints.clear();
+    mSymbolsByUuid.clear();
     qDeleteAll(mSymbols);           mSymbols.clear();
 
     mGridProperties.reset();
@@ -283,42 +298,58 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 {
     QPointF scenePosPx = pos.toPxQPointF();
+    QList<SI_NetPoint*> netpoints;
+    QList<SI_NetLine*> netlines;
+    QList<SI_NetLabel*> netlabels;
+    QList<SI_Symbol*> symbols;
+    QList<SI_SymbolPin*> pins;
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        switch (item->getType()) {
+            case SI_Base::Type_t::NetPoint:     netpoints.append(static_cast<SI_NetPoint*>(item)); break;
+            case SI_Base::Type_t::NetLine:      netlines.append(static_cast<SI_NetLine*>(item)); break;
+            case SI_Base::Type_t::NetLabel:     netlabels.append(static_cast<SI_NetLabel*>(item)); break;
+            case SI_Base::Type_t::Symbol:       symbols.append(static_cast<SI_Symbol*>(item)); break;
+            case SI_Base::Type_t::SymbolPin:    pins.append(static_cast<SI_SymbolPin*>(item)); break;
+            default: break;
+        }
+    }
+
     QList<SI_Base*> list;   // Note: The order of adding the items is very important (the
                             // top most item must appear as the first item in the list)!
     // visible netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
+    foreach (SI_NetPoint* netpoint, netpoints)
     {
         if (!netpoint->isVisible()) continue;
         if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
             list.append(netpoint);
     }
     // hidden netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
+    foreach (SI_NetPoint* netpoint, netpoints)
     {
         if (netpoint->isVisible()) continue;
         if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
             list.append(netpoint);
     }
     // netlines
-    foreach (SI_NetLine* netline, mNetLines)
+    foreach (SI_NetLine* netline, netlines)
     {
         if (netline->getGrabAreaScenePx().contains(scenePosPx))
             list.append(netline);
     }
     // netlabels
-    foreach (SI_NetLabel* netlabel, mNetLabels)
+    foreach (SI_NetLabel* netlabel, netlabels)
     {
         if (netlabel->getGrabAreaScenePx().contains(scenePosPx))
             list.append(netlabel);
     }
-    // symbols & pins
-    foreach (SI_Symbol* symbol, mSymbols)
+    // pins & symbols
+    foreach (SI_SymbolPin* pin, pins)
+    {
+        if (pin->getGrabAreaScenePx().contains(scenePosPx))
+            list.append(pin);
+    }
+    foreach (SI_Symbol* symbol, symbols)
     {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
-        {
-            if (pin->getGrabAreaScenePx().contains(scenePosPx))
-                list.append(pin);
-        }
         if (symbol->getGrabAreaScenePx().contains(scenePosPx))
             list.append(symbol);
     }
@@ -328,8 +359,9 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_NetPoint*> list;
-    foreach (SI_NetPoint* netpoint, mNetPoints)
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos, SI_Base::Type_t::NetPoint))
     {
+        SI_NetPoint* netpoint = static_cast<SI_NetPoint*>(item);
         if (netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()))
             list.append(netpoint);
     }
@@ -339,8 +371,9 @@ QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const no
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_NetLine*> list;
-    foreach (SI_NetLine* netline, mNetLines)
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos, SI_Base::Type_t::NetLine))
     {
+        SI_NetLine* netline = static_cast<SI_NetLine*>(item);
         if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF()))
             list.append(netline);
     }
@@ -350,13 +383,11 @@ QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noex
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_SymbolPin*> list;
-    foreach (SI_Symbol* symbol, mSymbols)
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos, SI_Base::Type_t::SymbolPin))
     {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
-        {
-            if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-                list.append(pin);
-        }
+        SI_SymbolPin* pin = static_cast<SI_SymbolPin*>(item);
+        if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
+            list.append(pin);
     }
     return list;
 }
@@ -390,16 +421,12 @@ void Schematic::setGridProperties(const GridProperties& grid) noexcept
 
 SI_Symbol* Schematic::getSymbolByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (SI_Symbol* symbol, mSymbols) {
-        if (symbol->getUuid() == uuid)
-            return symbol;
-    }
-    return nullptr;
+    return mSymbolsByUuid.value(uuid, nullptr);
 }
 
 void Schematic::addSymbol(SI_Symbol& symbol) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mSymbols.contains(&symbol))
+    if ((!mIsAddedToProject) || (getSymbolByUuid(symbol.getUuid()) == &symbol)
         || (&symbol.getSchematic() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -413,16 +440,18 @@ void Schematic::addSymbol(SI_Symbol& symbol) throw (Exception)
     // add to schematic
     symbol.addToSchematic(*mGraphicsScene); // can throw
     mSymbols.append(&symbol);
+    mSymbolsByUuid.insert(symbol.getUuid(), &symbol);
 }
 
 void Schematic::removeSymbol(SI_Symbol& symbol) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mSymbols.contains(&symbol))) {
+    if ((!mIsAddedToProject) || (getSymbolByUuid(symbol.getUuid()) != &symbol)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from schematic
     symbol.removeFromSchematic(*mGraphicsScene); // can throw
     mSymbols.removeOne(&symbol);
+    mSymbolsByUuid.remove(symbol.getUuid());
 }
 
 /*****************************************************************************************
@@ -431,16 +460,12 @@ void Schematic::removeSymbol(SI_Symbol& symbol) throw (Exception)
 
 SI_NetPoint* Schematic::getNetPointByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (SI_NetPoint* netpoint, mNetPoints) {
-        if (netpoint->getUuid() == uuid)
-            return netpoint;
-    }
-    return nullptr;
+    return mNetPointsByUuid.value(uuid, nullptr);
 }
 
 void Schematic::addNetPoint(SI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetPoints.contains(&netpoint))
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) == &netpoint)
         || (&netpoint.getSchematic() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -454,16 +479,18 @@ void Schematic::addNetPoint(SI_NetPoint& netpoint) throw (Exception)
     // add to schematic
     netpoint.addToSchematic(*mGraphicsScene); // can throw
     mNetPoints.append(&netpoint);
+    mNetPointsByUuid.insert(netpoint.getUuid(), &netpoint);
 }
 
 void Schematic::removeNetPoint(SI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetPoints.contains(&netpoint))) {
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) != &netpoint)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from schematic
     netpoint.removeFromSchematic(*mGraphicsScene); // can throw an exception
     mNetPoints.removeOne(&netpoint);
+    mNetPointsByUuid.remove(netpoint.getUuid());
 }
 
 /*****************************************************************************************
@@ -472,16 +499,12 @@ void Schematic::removeNetPoint(SI_NetPoint& netpoint) throw (Exception)
 
 SI_NetLine* Schematic::getNetLineByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (SI_NetLine* netline, mNetLines) {
-        if (netline->getUuid() == uuid)
-            return netline;
-    }
-    return nullptr;
+    return mNetLinesByUuid.value(uuid, nullptr);
 }
 
 void Schematic::addNetLine(SI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetLines.contains(&netline))
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) == &netline)
         || (&netline.getSchematic() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -495,16 +518,18 @@ void Schematic::addNetLine(SI_NetLine& netline) throw (Exception)
     // add to schematic
     netline.addToSchematic(*mGraphicsScene); // can throw
     mNetLines.append(&netline);
+    mNetLinesByUuid.insert(netline.getUuid(), &netline);
 }
 
 void Schematic::removeNetLine(SI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetLines.contains(&netline))) {
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) != &netline)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from schematic
     netline.removeFromSchematic(*mGraphicsScene); // can throw
     mNetLines.removeOne(&netline);
+    mNetLinesByUuid.remove(netline.getUuid());
 }
 
 /*****************************************************************************************
@@ -513,16 +538,12 @@ void Schematic::removeNetLine(SI_NetLine& netline) throw (Exception)
 
 SI_NetLabel* Schematic::getNetLabelByUuid(const Uuid& uuid) const noexcept
 {
-    foreach (SI_NetLabel* netlabel, mNetLabels) {
-        if (netlabel->getUuid() == uuid)
-            return netlabel;
-    }
-    return nullptr;
+    return mNetLabelsByUuid.value(uuid, nullptr);
 }
 
 void Schematic::addNetLabel(SI_NetLabel& netlabel) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetLabels.contains(&netlabel))
+    if ((!mIsAddedToProject) || (getNetLabelByUuid(netlabel.getUuid()) == &netlabel)
         || (&netlabel.getSchematic() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -536,16 +557,18 @@ void Schematic::addNetLabel(SI_NetLabel& netlabel) throw (Exception)
     // add to schematic
     netlabel.addToSchematic(*mGraphicsScene); // can throw
     mNetLabels.append(&netlabel);
+    mNetLabelsByUuid.insert(netlabel.getUuid(), &netlabel);
 }
 
 void Schematic::removeNetLabel(SI_NetLabel& netlabel) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetLabels.contains(&netlabel))) {
+    if ((!mIsAddedToProject) || (getNetLabelByUuid(netlabel.getUuid()) != &netlabel)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from schematic
     netlabel.removeFromSchematic(*mGraphicsScene); // can throw
     mNetLabels.removeOne(&netlabel);
+    mNetLabelsByUuid.remove(netlabel.getUuid());
 }
 
 /*****************************************************************************************
@@ -612,6 +635,33 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Schematic::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // take a snapshot of the schematic XML file
+    try
+    {
+        if (mIsAddedToProject)
+        {
+            QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+            doc->setFileVersion(APP_VERSION_MAJOR);
+            jobs.append(mXmlFile->prepareAutosave(doc)); // written later by the caller
+        }
+        else
+        {
+            mXmlFile->removeFile(false);
+        }
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
+    }
+
+    return success;
+}
+
 void Schematic::showInView(GraphicsView& view) noexcept
 {
     view.setScene(mGraphicsScene.data());
@@ -692,6 +742,33 @@ bool Schematic::getAttributeValue(const QString& attrNS, const QString& attrKey,
  *  Private Methods
  ****************************************************************************************/
 
+QList<SI_Base*> Schematic::getItemCandidatesAtScenePos(const Point& pos) const noexcept
+{
+    // The BSP tree of the graphics scene is a spatial index of the bounding rects of all
+    // items added to the schematic, which is kept up to date by Qt (see Board).
+    QList<SI_Base*> list;
+    foreach (QGraphicsItem* item, mGraphicsScene->items(pos.toPxQPointF(),
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        SGI_Base* schematicItem = dynamic_cast<SGI_Base*>(item);
+        if (schematicItem) {
+            list.append(&schematicItem->getSchematicItem());
+        }
+    }
+    return list;
+}
+
+QList<SI_Base*> Schematic::getItemCandidatesAtScenePos(const Point& pos, SI_Base::Type_t type) const noexcept
+{
+    QList<SI_Base*> list;
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (item->getType() == type) {
+            list.append(item);
+        }
+    }
+    return list;
+}
+
 void Schematic::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
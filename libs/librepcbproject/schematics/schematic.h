@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <QtWidgets>
 #include <librepcbcommon/uuid.h>
 #include <librepcbcommon/if_attributeprovider.h>
@@ -31,6 +32,7 @@
 #include <librepcbcommon/units/all_length_units.h>
 #include <librepcbcommon/fileio/filepath.h>
 #include <librepcbcommon/exceptions.h>
+#include "items/si_base.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -41,6 +43,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartXmlFile;
+class XmlDomDocument;
 
 namespace project {
 
@@ -103,8 +106,9 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         // Constructors / Destructor
         Schematic() = delete;
         Schematic(const Schematic& other) = delete;
-        Schematic(Project& project, const FilePath& filepath, bool restore, bool readOnly) throw (Exception) :
-            Schematic(project, filepath, restore, readOnly, false, QString()) {}
+        Schematic(Project& project, const FilePath& filepath, bool restore, bool readOnly,
+                  const QSharedPointer<XmlDomDocument>& parsedDoc = QSharedPointer<XmlDomDocument>()) throw (Exception) :
+            Schematic(project, filepath, restore, readOnly, false, QString(), parsedDoc) {}
         ~Schematic() noexcept;
 
         // Getters: General
@@ -161,6 +165,7 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         void addToProject() throw (Exception);
         void removeFromProject() throw (Exception);
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
         void showInView(GraphicsView& view) noexcept;
         void saveViewSceneRect(const QRectF& rect) noexcept {mViewRect = rect;}
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
@@ -191,9 +196,21 @@ class Schematic final : public QObject, public IF_AttributeProvider,
     private:
 
         Schematic(Project& project, const FilePath& filepath, bool restore,
-                  bool readOnly, bool create, const QString& newName) throw (Exception);
+                  bool readOnly, bool create, const QString& newName,
+                  const QSharedPointer<XmlDomDocument>& parsedDoc = QSharedPointer<XmlDomDocument>()) throw (Exception);
         void updateIcon() noexcept;
 
+        /**
+         * @brief Get all items whose bounding rect contains a given position
+         *
+         * @param pos   The scene position
+         *
+         * @return All items found in the index of the graphics scene (top most first),
+         *         the caller has to check their grab area
+         */
+        QList<SI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
+        QList<SI_Base*> getItemCandidatesAtScenePos(const Point& pos, SI_Base::Type_t type) const noexcept;
+
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
 
@@ -220,6 +237,10 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         QList<SI_NetPoint*> mNetPoints;
         QList<SI_NetLine*> mNetLines;
         QList<SI_NetLabel*> mNetLabels;
+        QHash<Uuid, SI_Symbol*> mSymbolsByUuid;         ///< index of #mSymbols
+        QHash<Uuid, SI_NetPoint*> mNetPointsByUuid;     ///< index of #mNetPoints
+        QHash<Uuid, SI_NetLine*> mNetLinesByUuid;       ///< index of #mNetLines
+        QHash<Uuid, SI_NetLabel*> mNetLabelsByUuid;     ///< index of #mNetLabels
 };
 
 /*****************************************************************************************
@@ -131,6 +131,26 @@ bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool ProjectSettings::prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // Save "core/settings.xml"
+    try
+    {
+        QSharedPointer<XmlDomDocument> doc(new XmlDomDocument(*serializeToXmlDomElement()));
+        doc->setFileVersion(APP_VERSION_MAJOR);
+        jobs.append(mXmlFile->prepareAutosave(doc)); // written later by the caller
+    }
+    catch (Exception& e)
+    {
+        success = false;
+        errors.append(e.getUserMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcbcommon/fileio/if_xmlserializableobject.h>
 #include <librepcbcommon/fileio/filepath.h>
 
@@ -73,6 +74,7 @@ class ProjectSettings final : public QObject, public IF_XmlSerializableObject
         void restoreDefaults() noexcept;
         void triggerSettingsChanged() noexcept;
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool prepareAutosave(QList<std::function<void()>>& jobs, QStringList& errors) noexcept;
 
 
     signals:
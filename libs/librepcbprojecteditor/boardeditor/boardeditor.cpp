@@ -457,6 +457,16 @@ void BoardEditor::on_actionModifyDesignRules_triggered()
     }
 }
 
+void BoardEditor::on_actionRunDesignRuleCheck_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    board->runDesignRuleCheck();
+    QApplication::restoreOverrideCursor();
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index)
 {
     setActiveBoardIndex(index);
@@ -71,9 +71,24 @@ void FabricationOutputDialog::on_btnGenerate_clicked()
     if (filepath.mkPath()) {
         try
         {
+            QProgressDialog progressDialog(tr("Generating fabrication output..."),
+                                           tr("Cancel"), 0, 0, this);
+            progressDialog.setWindowModality(Qt::WindowModal);
+            progressDialog.setMinimumDuration(500);
             BoardGerberExport grbExport(mBoard, filepath);
+            connect(&grbExport, &BoardGerberExport::progress,
+                    [&progressDialog](int finishedFiles, int totalFiles) {
+                progressDialog.setMaximum(totalFiles);
+                progressDialog.setValue(finishedFiles);
+            });
+            connect(&progressDialog, &QProgressDialog::canceled,
+                    &grbExport, &BoardGerberExport::cancel);
             grbExport.exportAllLayers();
         }
+        catch (UserCanceled& e)
+        {
+            // nothing to do
+        }
         catch (Exception& e)
         {
             QMessageBox::warning(this, tr("Error"), e.getUserMsg());
@@ -48,10 +48,10 @@ CmdMoveSelectedBoardItems::CmdMoveSelectedBoardItems(Board& board, const Point&
     mBoard(board), mStartPos(startPos), mDeltaPos(0, 0)
 {
     // get all selected items
-    QList<BI_Base*> items = mBoard.getSelectedItems(true, false, true, false, true, false,
-                                                    false, false, false, false, false, false);
+    mItems = mBoard.getSelectedItems(true, false, true, false, true, false,
+                                     false, false, false, false, false, false);
 
-    foreach (BI_Base* item, items) {
+    foreach (BI_Base* item, mItems) {
         switch (item->getType())
         {
             case BI_Base::Type_t::Footprint: {
@@ -137,6 +137,54 @@ bool CmdMoveSelectedBoardItems::performExecute() throw (Exception)
     return UndoCommandGroup::performExecute(); // can throw
 }
 
+bool CmdMoveSelectedBoardItems::performCanMergeWith(const UndoCommand& other) const noexcept
+{
+    // Only consecutive moves of exactly the same items are merged. As "other" was
+    // executed directly after this command, each of its child commands starts where the
+    // corresponding child command of this command ended, so the childs can be merged
+    // pairwise and the deltas add up. All pairs are checked before anything is merged,
+    // so a failing pair can't leave this command partially merged.
+    const CmdMoveSelectedBoardItems* cmd = dynamic_cast<const CmdMoveSelectedBoardItems*>(&other);
+    if ((!cmd) || (&cmd->mBoard != &mBoard) || (cmd->mItems != mItems)) return false;
+    if ((cmd->mDeviceEditCmds.count() != mDeviceEditCmds.count()) ||
+        (cmd->mViaEditCmds.count() != mViaEditCmds.count()) ||
+        (cmd->mNetPointEditCmds.count() != mNetPointEditCmds.count())) {
+        return false;
+    }
+    for (int i = 0; i < mDeviceEditCmds.count(); ++i) {
+        if (!mDeviceEditCmds.at(i)->canMergeWith(*cmd->mDeviceEditCmds.at(i))) return false;
+    }
+    for (int i = 0; i < mViaEditCmds.count(); ++i) {
+        if (!mViaEditCmds.at(i)->canMergeWith(*cmd->mViaEditCmds.at(i))) return false;
+    }
+    for (int i = 0; i < mNetPointEditCmds.count(); ++i) {
+        if (!mNetPointEditCmds.at(i)->canMergeWith(*cmd->mNetPointEditCmds.at(i))) return false;
+    }
+    return true;
+}
+
+bool CmdMoveSelectedBoardItems::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdMoveSelectedBoardItems* cmd = dynamic_cast<const CmdMoveSelectedBoardItems*>(&other);
+    if ((!cmd) || (!performCanMergeWith(other))) return false;
+
+    bool merged = true;
+    for (int i = 0; i < mDeviceEditCmds.count(); ++i) {
+        merged = mDeviceEditCmds.at(i)->mergeWith(*cmd->mDeviceEditCmds.at(i)) && merged;
+    }
+    for (int i = 0; i < mViaEditCmds.count(); ++i) {
+        merged = mViaEditCmds.at(i)->mergeWith(*cmd->mViaEditCmds.at(i)) && merged;
+    }
+    for (int i = 0; i < mNetPointEditCmds.count(); ++i) {
+        merged = mNetPointEditCmds.at(i)->mergeWith(*cmd->mNetPointEditCmds.at(i)) && merged;
+    }
+    Q_ASSERT(merged); // all pairs were checked by performCanMergeWith()
+    if (merged) {
+        mDeltaPos += cmd->mDeltaPos;
+    }
+    return merged;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -34,6 +34,7 @@ namespace librepcb {
 namespace project {
 
 class Board;
+class BI_Base;
 class CmdDeviceInstanceEdit;
 class CmdBoardViaEdit;
 class CmdBoardNetPointEdit;
@@ -53,6 +54,11 @@ class CmdMoveSelectedBoardItems final : public UndoCommandGroup
         CmdMoveSelectedBoardItems(Board& board, const Point& startPos) noexcept;
         ~CmdMoveSelectedBoardItems() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getMergeId()
+        int getMergeId() const noexcept override {return 1004;}
+
         // General Methods
         void setCurrentPosition(const Point& pos) noexcept;
 
@@ -64,11 +70,18 @@ class CmdMoveSelectedBoardItems final : public UndoCommandGroup
         /// @copydoc UndoCommand::performExecute()
         bool performExecute() throw (Exception) override;
 
+        /// @copydoc UndoCommand::performCanMergeWith()
+        bool performCanMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        bool performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
         Board& mBoard;
         Point mStartPos;
         Point mDeltaPos;
+        QList<BI_Base*> mItems; ///< the selected items when the command was created
 
         // Move commands
         QList<CmdDeviceInstanceEdit*> mDeviceEditCmds;
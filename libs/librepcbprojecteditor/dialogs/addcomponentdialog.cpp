@@ -59,6 +59,11 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace, Project&
 {
     mUi->setupUi(this);
     mPreviewScene = new GraphicsScene();
+
+    // do not query the library on every keystroke, but only when typing has paused
+    mSearchTimer.setSingleShot(true);
+    mSearchTimer.setInterval(200);
+    connect(&mSearchTimer, &QTimer::timeout, this, &AddComponentDialog::searchTimerTimeout);
     mUi->graphicsView->setScene(mPreviewScene);
     mUi->graphicsView->setOriginCrossVisible(false);
 
@@ -105,6 +110,30 @@ Uuid AddComponentDialog::getSelectedSymbVarUuid() const noexcept
  *  Private Slots
  ****************************************************************************************/
 
+void AddComponentDialog::on_edtSearch_textChanged(const QString& text)
+{
+    Q_UNUSED(text);
+    mSearchTimer.start(); // restarts the timer if it is already running
+}
+
+void AddComponentDialog::searchTimerTimeout()
+{
+    try
+    {
+        QString text = mUi->edtSearch->text();
+        if (text.trimmed().isEmpty()) {
+            QModelIndex index = mUi->treeCategories->currentIndex();
+            setSelectedCategory(Uuid(index.data(Qt::UserRole).toString()));
+        } else {
+            searchComponents(text);
+        }
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::critical(this, tr("Error"), e.getUserMsg());
+    }
+}
+
 void AddComponentDialog::treeCategories_currentItemChanged(const QModelIndex& current, const QModelIndex& previous)
 {
     Q_UNUSED(previous);
@@ -155,6 +184,28 @@ void AddComponentDialog::on_cbxSymbVar_currentIndexChanged(int index)
  *  Private Methods
  ****************************************************************************************/
 
+void AddComponentDialog::searchComponents(const QString& input)
+{
+    setSelectedComponent(nullptr);
+    mUi->listComponents->clear();
+    mSelectedCategoryUuid = Uuid(); // enforce reloading the category when search is cleared
+
+    QList<library::Library::SearchResult> results = mWorkspace.getLibrary().search(
+        input, library::Library::Components, mProject.getSettings().getLocaleOrder(), 500);
+    QSet<Uuid> components;
+    foreach (const library::Library::SearchResult& result, results)
+    {
+        if (components.contains(result.uuid)) continue; // other version of same component
+        components.insert(result.uuid);
+        FilePath cmpFp = mWorkspace.getLibrary().getLatestComponent(result.uuid);
+        if (!cmpFp.isValid()) continue;
+
+        QListWidgetItem* item = new QListWidgetItem(result.name);
+        item->setData(Qt::UserRole, cmpFp.toStr());
+        mUi->listComponents->addItem(item);
+    }
+}
+
 void AddComponentDialog::setSelectedCategory(const Uuid& categoryUuid)
 {
     if ((categoryUuid == mSelectedCategoryUuid) && (!categoryUuid.isNull())) return;
@@ -166,15 +217,20 @@ void AddComponentDialog::setSelectedCategory(const Uuid& categoryUuid)
     const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
 
     mSelectedCategoryUuid = categoryUuid;
-    QSet<Uuid> components = mWorkspace.getLibrary().getComponentsByCategory(categoryUuid);
-    foreach (const Uuid& cmpUuid, components)
+    QList<library::Library::ComponentMetadata> components =
+        mWorkspace.getLibrary().getComponentsMetadataByCategory(categoryUuid);
+    foreach (const library::Library::ComponentMetadata& component, components)
     {
-        FilePath cmpFp = mWorkspace.getLibrary().getLatestComponent(cmpUuid);
-        if (!cmpFp.isValid()) continue;
-        library::Component component(cmpFp, true); // TODO: use library metadata instead of loading the whole component
+        QStringList symbVarNames;
+        foreach (const library::Library::SymbolVariantMetadata& symbVar, component.symbolVariants) {
+            symbVarNames.append(localeString(symbVar.names, localeOrder));
+        }
 
-        QListWidgetItem* item = new QListWidgetItem(component.getName(localeOrder));
-        item->setData(Qt::UserRole, cmpFp.toStr());
+        QListWidgetItem* item = new QListWidgetItem(localeString(component.names, localeOrder));
+        item->setToolTip(QString("%1\n%2: %3")
+                         .arg(localeString(component.descriptions, localeOrder),
+                              tr("Symbol Variants"), symbVarNames.join(", ")));
+        item->setData(Qt::UserRole, component.filepath.toStr());
         mUi->listComponents->addItem(item);
     }
 }
@@ -268,6 +324,23 @@ void AddComponentDialog::accept() noexcept
     QDialog::accept();
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString AddComponentDialog::localeString(const QMap<QString, QString>& list,
+                                         const QStringList& localeOrder) noexcept
+{
+    try
+    {
+        return library::LibraryBaseElement::localeStringFromList(list, localeOrder);
+    }
+    catch (const Exception&)
+    {
+        return list.isEmpty() ? QString() : list.first(); // no en_US translation
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -87,6 +87,8 @@ class AddComponentDialog final : public QDialog
 
     private slots:
 
+        void on_edtSearch_textChanged(const QString& text);
+        void searchTimerTimeout();
         void treeCategories_currentItemChanged(const QModelIndex& current, const QModelIndex& previous);
         void on_listComponents_currentItemChanged(QListWidgetItem *current, QListWidgetItem *previous);
         void on_cbxSymbVar_currentIndexChanged(int index);
@@ -95,10 +97,13 @@ class AddComponentDialog final : public QDialog
     private:
 
         // Private Methods
+        void searchComponents(const QString& input);
         void setSelectedCategory(const Uuid& categoryUuid);
         void setSelectedComponent(const library::Component* cmp);
         void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
         void accept() noexcept;
+        static QString localeString(const QMap<QString, QString>& list,
+                                    const QStringList& localeOrder) noexcept;
 
 
         // General
@@ -107,6 +112,7 @@ class AddComponentDialog final : public QDialog
         Ui::AddComponentDialog* mUi;
         GraphicsScene* mPreviewScene;
         library::CategoryTreeModel* mCategoryTreeModel;
+        QTimer mSearchTimer; ///< delays the search while the user is typing
 
 
         // Attributes
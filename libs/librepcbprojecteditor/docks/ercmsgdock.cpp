@@ -103,6 +103,10 @@ ErcMsgDock::ErcMsgDock(Project& project) :
         mErcMsgItems.insert(ercMsg, child);
     }
 
+    // sort the messages (the ERC message list is not ordered)
+    foreach (QTreeWidgetItem* item, mTopLevelItems)
+        item->sortChildren(0, Qt::AscendingOrder);
+
     // connect to ErcMsgList signals
     connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgAdded,    this, &ErcMsgDock::ercMsgAdded);
     connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgRemoved,  this, &ErcMsgDock::ercMsgRemoved);
@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtConcurrent>
 #include "projecteditor.h"
 #include <librepcbcommon/undostack.h>
 #include <librepcbworkspace/workspace.h>
@@ -62,6 +63,19 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
         throw; // ...and rethrow the exception
     }
 
+    // report the result of autosaves which were written in a worker thread
+    connect(&mAutosaveWatcher, &QFutureWatcher<void>::finished, this, [this]() {
+        try
+        {
+            mAutosaveWatcher.future().waitForFinished(); // rethrows the worker's exception
+            qDebug() << "Project successfully autosaved";
+        }
+        catch (Exception& exc)
+        {
+            qWarning() << "Could not autosave the project:" << exc.getDebugMsg();
+        }
+    });
+
     // setup the timer for automatic backups, if enabled in the settings
     int intervalSecs =  mWorkspace.getSettings().getProjectAutosaveInterval()->getInterval();
     if ((intervalSecs > 0) && (!project.isReadOnly()))
@@ -77,6 +91,9 @@ ProjectEditor::~ProjectEditor() noexcept
     // stop the autosave timer
     mAutoSaveTimer.stop();
 
+    // the project must not be destroyed while an autosave is writing its files
+    waitForAutosaveFinished();
+
     // abort all active commands!
     mSchematicEditor->abortAllCommands();
     mBoardEditor->abortAllCommands();
@@ -158,6 +175,9 @@ bool ProjectEditor::saveProject() noexcept
 {
     try
     {
+        // a running autosave would write the same temporary files, so wait for it
+        waitForAutosaveFinished();
+
         // step 1: save whole project to temporary files
         qDebug() << "Begin saving the project to temporary files...";
         mProject.save(false);
@@ -195,11 +215,21 @@ bool ProjectEditor::autosaveProject() noexcept
         return false;
     }
 
+    if (mAutosaveWatcher.isRunning())
+    {
+        // the previous autosave is still writing its files, so skip this one instead of
+        // queueing it (the next autosave will contain all changes anyway)
+        qDebug() << "Skipped autosave as the previous autosave is still running";
+        return false;
+    }
+
     try
     {
+        // take a snapshot of the project here, but do the (slow) formatting and writing
+        // of the temporary files in a worker thread to not block the user interface
         qDebug() << "Begin autosaving the project to temporary files...";
-        mProject.save(false);
-        qDebug() << "Project successfully autosaved";
+        std::function<void()> job = mProject.prepareAutosave();
+        mAutosaveWatcher.setFuture(QtConcurrent::run(job));
         return true;
     }
     catch (Exception& exc)
@@ -208,6 +238,18 @@ bool ProjectEditor::autosaveProject() noexcept
     }
 }
 
+void ProjectEditor::waitForAutosaveFinished() noexcept
+{
+    try
+    {
+        mAutosaveWatcher.future().waitForFinished();
+    }
+    catch (...)
+    {
+        // the error is already reported by the future watcher
+    }
+}
+
 bool ProjectEditor::closeAndDestroy(bool askForSave, QWidget* msgBoxParent) noexcept
 {
     if (((!mProject.isRestored()) && (mUndoStack->isClean())) || (mProject.isReadOnly()) || (!askForSave))
@@ -159,9 +159,13 @@ class ProjectEditor final : public QObject
         /**
          * @brief Make a automatic backup of the project (save to temporary files)
          *
+         * Only a snapshot of the project is taken in the calling thread, the files are
+         * written in a worker thread. If the previous autosave is still running, this
+         * autosave is skipped.
+         *
          * @note The whole save procedere is described in @ref doc_project_save.
          *
-         * @return true on success, false on failure
+         * @return true if the autosave was started, false if it was skipped or failed
          */
         bool autosaveProject() noexcept;
 
@@ -203,6 +207,9 @@ class ProjectEditor final : public QObject
         ProjectEditor(const Project& other) = delete;
         ProjectEditor& operator=(const Project& rhs) = delete;
 
+        // Private Methods
+        void waitForAutosaveFinished() noexcept;
+
 
         // Attributes
         workspace::Workspace& mWorkspace;
@@ -210,6 +217,7 @@ class ProjectEditor final : public QObject
 
         // General
         QTimer mAutoSaveTimer; ///< the timer for the periodically automatic saving functionality (see also @ref doc_project_save)
+        QFutureWatcher<void> mAutosaveWatcher; ///< the autosave which is written in a worker thread
         UndoStack* mUndoStack; ///< See @ref doc_project_undostack
         SchematicEditor* mSchematicEditor; ///< The schematic editor (GUI)
         BoardEditor* mBoardEditor; ///< The board editor (GUI)
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/airwiresbuilder.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class AirWiresBuilderTest : public ::testing::Test
+{
+    protected:
+
+        static qreal totalLength(const QList<AirWiresBuilder::AirWire>& airwires)
+        {
+            qreal length = 0;
+            foreach (const AirWiresBuilder::AirWire& airwire, airwires) {
+                length += (airwire.second - airwire.first).getLength().toMm();
+            }
+            return length;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(AirWiresBuilderTest, testNoPoints)
+{
+    AirWiresBuilder builder;
+    EXPECT_TRUE(builder.buildAirWires().isEmpty());
+}
+
+TEST_F(AirWiresBuilderTest, testAllConnected)
+{
+    AirWiresBuilder builder;
+    int p1 = builder.addPoint(Point::fromMm(0, 0));
+    int p2 = builder.addPoint(Point::fromMm(10, 0));
+    int p3 = builder.addPoint(Point::fromMm(10, 10));
+    builder.addEdge(p1, p2);
+    builder.addEdge(p3, p2);
+    EXPECT_TRUE(builder.buildAirWires().isEmpty());
+}
+
+TEST_F(AirWiresBuilderTest, testNearestIslandsAreConnected)
+{
+    // two islands: a trace from (0,0) to (10,0), and a trace from (12,0) to (30,0)
+    AirWiresBuilder builder;
+    int p1 = builder.addPoint(Point::fromMm(0, 0));
+    int p2 = builder.addPoint(Point::fromMm(10, 0));
+    int p3 = builder.addPoint(Point::fromMm(12, 0));
+    int p4 = builder.addPoint(Point::fromMm(30, 0));
+    builder.addEdge(p1, p2);
+    builder.addEdge(p3, p4);
+    QList<AirWiresBuilder::AirWire> airwires = builder.buildAirWires();
+    ASSERT_EQ(1, airwires.count());
+    EXPECT_NEAR(2.0, totalLength(airwires), 1e-6);
+}
+
+TEST_F(AirWiresBuilderTest, testMinimumSpanningTree)
+{
+    // points on a grid with 1mm pitch, the minimum spanning tree has a length of n-1
+    AirWiresBuilder builder;
+    int count = 0;
+    for (int x = 0; x < 20; ++x) {
+        for (int y = 0; y < 15; ++y) {
+            builder.addPoint(Point::fromMm(x, y));
+            ++count;
+        }
+    }
+    QList<AirWiresBuilder::AirWire> airwires = builder.buildAirWires();
+    EXPECT_EQ(count - 1, airwires.count());
+    EXPECT_NEAR(count - 1, totalLength(airwires), 1e-6);
+}
+
+TEST_F(AirWiresBuilderTest, testSamePosition)
+{
+    AirWiresBuilder builder;
+    builder.addPoint(Point::fromMm(5, 5));
+    builder.addPoint(Point::fromMm(5, 5));
+    builder.addPoint(Point::fromMm(5, 5));
+    QList<AirWiresBuilder::AirWire> airwires = builder.buildAirWires();
+    EXPECT_EQ(2, airwires.count());
+    EXPECT_NEAR(0.0, totalLength(airwires), 1e-6);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,263 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <librepcbcommon/clearancechecker.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ClearanceCheckerTest : public ::testing::Test
+{
+    protected:
+
+        typedef ClearanceChecker::Shape Shape;
+
+        static Shape point(qreal xMm, qreal yMm)
+        {
+            return ClearanceChecker::createObroundShape(Point::fromMm(xMm, yMm), Length(0),
+                                                        Length(0), Angle::deg0());
+        }
+
+        static Shape trace(qreal x1Mm, qreal y1Mm, qreal x2Mm, qreal y2Mm, qreal widthMm)
+        {
+            return ClearanceChecker::createTraceShape(Point::fromMm(x1Mm, y1Mm),
+                Point::fromMm(x2Mm, y2Mm), Length::fromMm(widthMm));
+        }
+
+        static qreal distanceMm(const Shape& a, const Shape& b)
+        {
+            return ClearanceChecker::distance(a, b) / 1e6;
+        }
+
+        /// Random traces of random nets in an area of 200x200mm
+        static QList<Shape> createRandomTraces(int count, quint32 seed = 42)
+        {
+            QList<Shape> traces;
+            for (int i = 0; i < count; ++i) {
+                seed = seed * 1103515245 + 12345;
+                qreal x = ((seed >> 8) % 200000) / 1000.0;
+                seed = seed * 1103515245 + 12345;
+                qreal y = ((seed >> 8) % 200000) / 1000.0;
+                seed = seed * 1103515245 + 12345;
+                qreal dx = ((seed >> 8) % 4000) / 1000.0 - 2;
+                seed = seed * 1103515245 + 12345;
+                qreal dy = ((seed >> 8) % 4000) / 1000.0 - 2;
+                traces.append(trace(x, y, x + dx, y + dy, 0.2));
+            }
+            return traces;
+        }
+
+        static QList<ClearanceChecker::Violation> checkAll(const ClearanceChecker& checker)
+        {
+            return checker.checkCells(checker.getCells());
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ClearanceCheckerTest, testParallelTraces)
+{
+    // center lines are 0.5mm apart, so 0.3mm remain between the 0.2mm wide traces
+    EXPECT_NEAR(0.3, distanceMm(trace(0, 0, 10, 0, 0.2), trace(0, 0.5, 10, 0.5, 0.2)), 1e-6);
+    // only partially overlapping in x, the distance is still perpendicular
+    EXPECT_NEAR(0.3, distanceMm(trace(0, 0, 10, 0, 0.2), trace(5, 0.5, 20, 0.5, 0.2)), 1e-6);
+    // not overlapping in x, the distance is measured between the end points
+    EXPECT_NEAR(qSqrt(2 * 2 + 0.5 * 0.5) - 0.2,
+                distanceMm(trace(0, 0, 10, 0, 0.2), trace(12, 0.5, 20, 0.5, 0.2)), 1e-6);
+    // overlapping and crossing traces have no clearance at all
+    EXPECT_EQ(0.0, distanceMm(trace(0, 0, 10, 0, 0.2), trace(0, 0.1, 10, 0.1, 0.2)));
+    EXPECT_EQ(0.0, distanceMm(trace(0, 0, 10, 0, 0.2), trace(5, -5, 5, 5, 0.2)));
+}
+
+TEST_F(ClearanceCheckerTest, testPointInsidePolygon)
+{
+    Shape rect = ClearanceChecker::createRectShape(Point::fromMm(0, 0), Length::fromMm(4),
+                                                   Length::fromMm(2), Angle::deg0());
+    EXPECT_TRUE(ClearanceChecker::contains(rect.vertices, QPointF(0, 0)));
+    EXPECT_TRUE(ClearanceChecker::contains(rect.vertices, QPointF(1.9e6, 0.9e6)));
+    EXPECT_TRUE(ClearanceChecker::contains(rect.vertices, QPointF(2e6, 0))); // on the edge
+    EXPECT_FALSE(ClearanceChecker::contains(rect.vertices, QPointF(2.1e6, 0)));
+    EXPECT_FALSE(ClearanceChecker::contains(rect.vertices, QPointF(0, -1.1e6)));
+
+    // shapes completely inside another shape have no edges in common, but no clearance
+    EXPECT_EQ(0.0, distanceMm(rect, point(0.5, 0.5)));
+    EXPECT_EQ(0.0, distanceMm(point(0.5, 0.5), rect));
+    EXPECT_EQ(0.0, distanceMm(rect, trace(-1, 0, 1, 0, 0.1)));
+    EXPECT_NEAR(1, distanceMm(rect, point(3, 0)), 1e-6);
+}
+
+TEST_F(ClearanceCheckerTest, testRotatedPads)
+{
+    Point center = Point::fromMm(10, 10);
+    Shape rect = ClearanceChecker::createRectShape(center, Length::fromMm(2),
+                                                   Length::fromMm(1), Angle::deg0());
+    Shape rect90 = ClearanceChecker::createRectShape(center, Length::fromMm(2),
+                                                     Length::fromMm(1), Angle::deg90());
+    Shape square45 = ClearanceChecker::createRectShape(center, Length::fromMm(1),
+                                                       Length::fromMm(1), Angle::deg45());
+    Shape obround90 = ClearanceChecker::createObroundShape(center, Length::fromMm(2),
+                                                           Length::fromMm(1), Angle::deg90());
+    Shape above = point(10, 11.5);
+    EXPECT_NEAR(1.0, distanceMm(rect, above), 1e-6);
+    EXPECT_NEAR(0.5, distanceMm(rect90, above), 1e-6);
+    EXPECT_NEAR(1.5 - qSqrt(0.5), distanceMm(square45, above), 1e-6);
+    EXPECT_NEAR(0.5, distanceMm(obround90, above), 1e-6);
+    EXPECT_NEAR(1.0, distanceMm(obround90, point(11.5, 10)), 1e-6);
+}
+
+TEST_F(ClearanceCheckerTest, testOctagonPads)
+{
+    Shape octagon = ClearanceChecker::createOctagonShape(Point::fromMm(0, 0),
+        Length::fromMm(1), Length::fromMm(1), Angle::deg0());
+    ASSERT_EQ(8, octagon.vertices.count());
+
+    // the straight edges are the same as of a square pad
+    EXPECT_NEAR(0.5, distanceMm(octagon, point(1, 0)), 1e-6);
+    EXPECT_NEAR(0.5, distanceMm(octagon, point(0, -1)), 1e-6);
+
+    // in a regular octagon, the diagonal edges have the same distance from the center
+    EXPECT_NEAR(qSqrt(2) - 0.5, distanceMm(octagon, point(1, 1)), 1e-5);
+    EXPECT_NEAR(qSqrt(2) - 0.5, distanceMm(octagon, point(-1, -1)), 1e-5);
+
+    // a rotated octagon pad does not only move its corners
+    Shape rotated = ClearanceChecker::createOctagonShape(Point::fromMm(0, 0),
+        Length::fromMm(2), Length::fromMm(1), Angle::deg90());
+    EXPECT_NEAR(0.5, distanceMm(rotated, point(0, 1.5)), 1e-6);
+    EXPECT_NEAR(1.0, distanceMm(rotated, point(1.5, 0)), 1e-6);
+}
+
+TEST_F(ClearanceCheckerTest, testItemsOfTheSameNetAreNotChecked)
+{
+    ClearanceChecker checker(Length::fromMm(0.2));
+    checker.addItem(trace(0, 0, 10, 0, 0.2), 1);
+    checker.addItem(trace(0, 0.3, 10, 0.3, 0.2), 1);  // same net
+    checker.addItem(trace(0, -0.3, 10, -0.3, 0.2), -1); // unconnected
+    checker.addItem(trace(0, -0.6, 10, -0.6, 0.2), -1); // unconnected
+    checker.buildGrid();
+
+    QSet<QPair<int, int>> pairs;
+    foreach (const ClearanceChecker::Violation& violation, checkAll(checker)) {
+        pairs.insert(qMakePair(qMin(violation.item1, violation.item2),
+                               qMax(violation.item1, violation.item2)));
+        EXPECT_EQ(Length::fromMm(0.1), violation.clearance);
+    }
+    QSet<QPair<int, int>> expected;
+    expected << qMakePair(0, 2) << qMakePair(2, 3);
+    EXPECT_EQ(expected, pairs);
+}
+
+TEST_F(ClearanceCheckerTest, testPairSpanningSeveralCellsIsReportedOnce)
+{
+    ClearanceChecker checker(Length::fromMm(0.2));
+    checker.addItem(trace(0, 0, 10, 0, 0.2), 1);
+    checker.addItem(trace(0, 0.25, 10, 0.25, 0.2), 2);
+    checker.addItem(point(5, -5), 3); // does not touch the other items
+    checker.buildGrid(Length::fromMm(1));
+    ASSERT_GT(checker.getCells().count(), 10);
+
+    // all cells at once
+    QList<ClearanceChecker::Violation> violations = checkAll(checker);
+    ASSERT_EQ(1, violations.count());
+    EXPECT_EQ(Length::fromMm(0.05), violations.first().clearance);
+
+    // each cell separately, like the chunks checked by different threads
+    int count = 0;
+    foreach (const ClearanceChecker::CellIndex& cell, checker.getCells()) {
+        QVector<ClearanceChecker::CellIndex> cells;
+        cells.append(cell);
+        count += checker.checkCells(cells).count();
+    }
+    EXPECT_EQ(1, count);
+}
+
+TEST_F(ClearanceCheckerTest, testExactClearanceIsNoViolation)
+{
+    ClearanceChecker checker(Length::fromMm(0.2));
+    checker.addItem(trace(0, 0, 10, 0, 0.2), 1);
+    checker.addItem(trace(0, 0.4, 10, 0.4, 0.2), 2);
+    checker.buildGrid();
+    EXPECT_TRUE(checkAll(checker).isEmpty());
+}
+
+/**
+ * Runtime of the grid based check compared to checking all pairs of items (with a cheap
+ * bounding box test first), for 20'000 trace segments. Run it explicitly with
+ * "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(ClearanceCheckerTest, DISABLED_benchmarkCheck20kSegments)
+{
+    QList<Shape> traces = createRandomTraces(20000);
+    ClearanceChecker checker(Length::fromMm(0.2));
+    for (int i = 0; i < traces.count(); ++i) {
+        checker.addItem(traces.at(i), i);
+    }
+    QElapsedTimer timer;
+
+    timer.start();
+    checker.buildGrid();
+    qint64 gridMs = timer.elapsed();
+    timer.start();
+    int gridViolations = checkAll(checker).count();
+    qint64 checkMs = timer.elapsed();
+
+    timer.start();
+    int bruteForceViolations = 0;
+    qreal margin = checker.getClearance().toNm() / 2;
+    for (int i = 0; i < traces.count(); ++i) {
+        QRectF rectA = traces.at(i).bounds.adjusted(-margin, -margin, margin, margin);
+        for (int k = i + 1; k < traces.count(); ++k) {
+            QRectF rectB = traces.at(k).bounds.adjusted(-margin, -margin, margin, margin);
+            if (!rectA.intersects(rectB)) continue;
+            qreal d = ClearanceChecker::distance(traces.at(i), traces.at(k));
+            if (d + 1 < checker.getClearance().toNm()) ++bruteForceViolations;
+        }
+    }
+    qint64 bruteForceMs = timer.elapsed();
+    EXPECT_EQ(bruteForceViolations, gridViolations);
+
+    std::cout << "Segments:    " << traces.count() << std::endl;
+    std::cout << "Violations:  " << gridViolations << std::endl;
+    std::cout << "Grid:        " << gridMs << " ms to build, " << checkMs << " ms to check "
+              << "(" << checker.getCells().count() << " cells, single thread)" << std::endl;
+    std::cout << "All pairs:   " << bruteForceMs << " ms" << std::endl;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,208 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <algorithm>
+#include <QtCore>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/excellongenerator.h>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ExcellonGeneratorTest : public ::testing::Test
+{
+    protected:
+
+        /// Random hits on a 100x100mm board with a 1um grid (always the same sequence)
+        static QList<Point> createRandomHits(int count, quint32 seed = 42)
+        {
+            QList<Point> hits;
+            for (int i = 0; i < count; ++i) {
+                seed = seed * 1103515245 + 12345;
+                qint64 x = (seed >> 8) % 100000;
+                seed = seed * 1103515245 + 12345;
+                qint64 y = (seed >> 8) % 100000;
+                hits.append(Point(Length(x * 1000), Length(y * 1000)));
+            }
+            return hits;
+        }
+
+        /// The hits of all tools of a generated Excellon file, in drill order
+        static QList<Point> parseHits(const QString& output)
+        {
+            QList<Point> hits;
+            QRegularExpression regex("^X([-0-9.]+)Y([-0-9.]+)$");
+            foreach (const QString& line, output.split('\n')) {
+                QRegularExpressionMatch match = regex.match(line);
+                if (match.hasMatch()) {
+                    hits.append(Point(Length::fromMm(match.captured(1)),
+                                      Length::fromMm(match.captured(2))));
+                }
+            }
+            return hits;
+        }
+
+        static QList<Point> generate(const QList<Point>& hits, bool optimize)
+        {
+            ExcellonGenerator gen;
+            gen.setDrillOrderOptimizationEnabled(optimize);
+            foreach (const Point& pos, hits) {
+                gen.drill(pos, Length::fromMm(0.8));
+            }
+            gen.generate();
+            return parseHits(gen.toStr());
+        }
+
+        /// The travel distance in nanometers, starting at the origin
+        static qreal travelLength(const QList<Point>& hits)
+        {
+            qreal length = 0;
+            Point current;
+            foreach (const Point& pos, hits) {
+                qreal dx = pos.getX().toNm() - current.getX().toNm();
+                qreal dy = pos.getY().toNm() - current.getY().toNm();
+                length += qSqrt(dx * dx + dy * dy);
+                current = pos;
+            }
+            return length;
+        }
+
+        static QList<QPair<qint64, qint64>> sorted(const QList<Point>& hits)
+        {
+            QList<QPair<qint64, qint64>> list;
+            foreach (const Point& pos, hits) {
+                list.append(qMakePair(pos.getX().toNm(), pos.getY().toNm()));
+            }
+            std::sort(list.begin(), list.end());
+            return list;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ExcellonGeneratorTest, testOptimizedOrderIsPermutationOfInput)
+{
+    QList<Point> hits = createRandomHits(2000);
+    hits.append(hits.mid(0, 100)); // duplicate hits must not get lost
+    QList<Point> optimized = generate(hits, true);
+    EXPECT_EQ(hits.count(), optimized.count());
+    EXPECT_EQ(sorted(hits), sorted(optimized));
+
+    // several tools: each tool contains exactly its own hits
+    ExcellonGenerator gen;
+    QList<Point> small = createRandomHits(500, 1);
+    QList<Point> large = createRandomHits(300, 2);
+    foreach (const Point& pos, small) gen.drill(pos, Length::fromMm(0.3));
+    foreach (const Point& pos, large) gen.drill(pos, Length::fromMm(3.0));
+    gen.generate();
+    QList<Point> output = parseHits(gen.toStr());
+    ASSERT_EQ(small.count() + large.count(), output.count());
+    EXPECT_EQ(sorted(small), sorted(output.mid(0, small.count())));
+    EXPECT_EQ(sorted(large), sorted(output.mid(small.count())));
+}
+
+TEST_F(ExcellonGeneratorTest, testOptimizedTravelIsNeverLonger)
+{
+    // random order
+    QList<Point> random = createRandomHits(3000);
+    EXPECT_LT(travelLength(generate(random, true)), travelLength(random));
+
+    // an already optimal serpentine order over a grid
+    QList<Point> serpentine;
+    for (int row = 0; row < 40; ++row) {
+        for (int col = 0; col < 40; ++col) {
+            int x = (row % 2) ? (39 - col) : col;
+            serpentine.append(Point(Length::fromMm(x * 2.54), Length::fromMm(row * 2.54)));
+        }
+    }
+    EXPECT_LE(travelLength(generate(serpentine, true)), travelLength(serpentine));
+
+    // degenerated inputs
+    QList<Point> line;
+    for (int i = 0; i < 100; ++i) line.append(Point(Length::fromMm(i), Length(0)));
+    EXPECT_LE(travelLength(generate(line, true)), travelLength(line));
+    QList<Point> same;
+    for (int i = 0; i < 50; ++i) same.append(Point(Length::fromMm(5), Length::fromMm(5)));
+    EXPECT_LE(travelLength(generate(same, true)), travelLength(same));
+    for (int count = 0; count < 4; ++count) {
+        QList<Point> few = createRandomHits(count, count);
+        EXPECT_LE(travelLength(generate(few, true)), travelLength(few));
+    }
+}
+
+TEST_F(ExcellonGeneratorTest, testOptimizationIsDeterministic)
+{
+    QList<Point> hits = createRandomHits(5000);
+    QList<Point> first = generate(hits, true);
+    QList<Point> second = generate(hits, true);
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(ExcellonGeneratorTest, testDisabledOptimizationKeepsOrder)
+{
+    QList<Point> hits = createRandomHits(1000);
+    EXPECT_EQ(hits, generate(hits, false));
+}
+
+/**
+ * Travel distance and runtime of the drill order optimization for a large board. Run it
+ * explicitly with "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(ExcellonGeneratorTest, DISABLED_benchmarkDrillOrderOptimization)
+{
+    QList<Point> hits = createRandomHits(50000);
+    QElapsedTimer timer;
+
+    timer.start();
+    QList<Point> unoptimized = generate(hits, false);
+    qint64 unoptimizedMs = timer.elapsed();
+
+    timer.start();
+    QList<Point> optimized = generate(hits, true);
+    qint64 optimizedMs = timer.elapsed();
+
+    qreal before = travelLength(unoptimized) / 1e6;
+    qreal after = travelLength(optimized) / 1e6;
+    std::cout << "Hits:        " << hits.count() << std::endl;
+    std::cout << "Unoptimized: " << before << " mm, generated in " << unoptimizedMs << " ms" << std::endl;
+    std::cout << "Optimized:   " << after << " mm, generated in " << optimizedMs << " ms "
+              << "(" << (100 - 100 * after / before) << "% shorter)" << std::endl;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,161 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <limits>
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/gerbergenerator.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test
+{
+    protected:
+
+        GerberGeneratorTest() :
+            mGen("project", Uuid("d2a6a8d2-4f4d-4a8b-9a3e-2c1f1a9b7e10"), "v1") {}
+
+        /// Random coordinates on a 100x100mm board (always the same sequence)
+        static QList<Point> createRandomPoints(int count, quint32 seed = 42)
+        {
+            QList<Point> points;
+            for (int i = 0; i < count; ++i) {
+                seed = seed * 1103515245 + 12345;
+                qint64 x = (seed >> 8) % 100000000;
+                seed = seed * 1103515245 + 12345;
+                qint64 y = (seed >> 8) % 100000000;
+                points.append(Point(Length(x - 50000000), Length(y - 50000000)));
+            }
+            return points;
+        }
+
+        /// Draws lines and flashes of all kinds of apertures
+        void drawSampleLayer()
+        {
+            QList<Point> points = createRandomPoints(500);
+            for (int i = 1; i < points.count(); ++i) {
+                mGen.drawLine(points[i-1], points[i], Length(100000 + (i % 7) * 50000));
+            }
+            for (int i = 0; i < points.count(); ++i) {
+                Length size(500000 + (i % 5) * 100000);
+                switch (i % 4) {
+                    case 0: mGen.flashCircle(points[i], size, Length(0)); break;
+                    case 1: mGen.flashRect(points[i], size, size * 2, Angle::deg90(), Length(0)); break;
+                    case 2: mGen.flashObround(points[i], size * 2, size, Angle::deg0(), Length(0)); break;
+                    default: mGen.flashRegularPolygon(points[i], size, 8, Angle::deg0(), Length(0)); break;
+                }
+            }
+            mGen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+            mGen.flashCircle(Point(Length(0), Length(0)), Length(1000000), Length(0));
+        }
+
+        /// Checks the "%TF.MD5,...*%" attribute the same way as it was calculated before
+        /// the output was streamed: over the whole preceding text without linebreaks
+        static void expectValidMd5Checksum(const QByteArray& output)
+        {
+            int index = output.indexOf("%TF.MD5,");
+            ASSERT_GE(index, 0);
+            int end = output.indexOf("*%", index);
+            ASSERT_GT(end, index);
+            QByteArray checksum = output.mid(index + 8, end - index - 8);
+            QString data = QString::fromLatin1(output.left(index)).remove(QChar('\n'));
+            QByteArray expected = QCryptographicHash::hash(data.toUtf8(),
+                                                           QCryptographicHash::Md5).toHex();
+            EXPECT_EQ(expected.toStdString(), checksum.toStdString());
+            EXPECT_TRUE(output.endsWith("*%\nM02*\n"));
+        }
+
+        GerberGenerator mGen;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberGeneratorTest, testNumbersAreFormattedLikeQStringNumber)
+{
+    LengthBase_t min = std::numeric_limits<LengthBase_t>::min();
+    LengthBase_t max = std::numeric_limits<LengthBase_t>::max();
+    QList<Point> points = {
+        Point(Length(0), Length(-1)), Point(Length(1), Length(9)),
+        Point(Length(10), Length(-10)), Point(Length(99), Length(100)),
+        Point(Length(999999), Length(-1000000)), Point(Length(min), Length(max)),
+        Point(Length(max), Length(min)), Point(Length(min + 1), Length(max - 1)),
+    };
+    points.append(createRandomPoints(1000));
+
+    QStringList expected;
+    foreach (const Point& pos, points) {
+        mGen.flashCircle(pos, Length(1000000), Length(0));
+        expected.append(QString("X%1Y%2D03*").arg(QString::number(pos.getX().toNm()),
+                                                 QString::number(pos.getY().toNm())));
+    }
+    mGen.generate();
+
+    QStringList actual;
+    foreach (const QString& line, QString::fromLatin1(mGen.toByteArray()).split('\n')) {
+        if (line.startsWith('X')) actual.append(line);
+    }
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(GerberGeneratorTest, testMd5ChecksumMatchesWholeText)
+{
+    drawSampleLayer();
+    mGen.generate();
+    expectValidMd5Checksum(mGen.toByteArray());
+}
+
+TEST_F(GerberGeneratorTest, testSavedFileHasValidMd5Checksum)
+{
+    drawSampleLayer();
+    FilePath dir = FilePath::getRandomTempPath();
+    FilePath filepath = dir.getPathTo("sample.gbr");
+    mGen.saveToFile(filepath);
+
+    QFile file(filepath.toStr());
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll();
+    file.close();
+    QDir(dir.toStr()).removeRecursively();
+
+    expectValidMd5Checksum(content);
+    EXPECT_TRUE(content.contains("G04 --- BOARD BEGIN --- *\n"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
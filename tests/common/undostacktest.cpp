@@ -0,0 +1,388 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/undostack.h>
+#include <librepcbcommon/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Command
+ ****************************************************************************************/
+
+/**
+ * @brief A command which sets an integer to a new value
+ */
+class SetValueCommand final : public UndoCommand
+{
+    public:
+
+        SetValueCommand(int& value, int newValue, qint64 memoryUsage = 0,
+                        int* deleteCounter = nullptr) noexcept :
+            UndoCommand("Set value"), mValue(value), mOldValue(0), mNewValue(newValue),
+            mMemoryUsage(memoryUsage), mDeleteCounter(deleteCounter) {}
+        ~SetValueCommand() noexcept {if (mDeleteCounter) ++(*mDeleteCounter);}
+
+        qint64 getApproxMemoryUsage() const noexcept override {
+            return (mMemoryUsage > 0) ? mMemoryUsage : UndoCommand::getApproxMemoryUsage();
+        }
+
+    private:
+
+        bool performExecute() throw (Exception) override {
+            mOldValue = mValue;
+            performRedo();
+            return true;
+        }
+        void performUndo() throw (Exception) override {mValue = mOldValue;}
+        void performRedo() throw (Exception) override {mValue = mNewValue;}
+
+        int& mValue;
+        int mOldValue;
+        int mNewValue;
+        qint64 mMemoryUsage;
+        int* mDeleteCounter;
+};
+
+/**
+ * @brief A mergeable command which adds a number to an integer
+ *
+ * Commands with a summand of zero refuse to be merged.
+ */
+class AddValueCommand final : public UndoCommand
+{
+    public:
+
+        AddValueCommand(int& value, int summand) noexcept :
+            UndoCommand("Add value"), mValue(value), mSummand(summand) {}
+
+        int getMergeId() const noexcept override {return 1;}
+
+    private:
+
+        bool performExecute() throw (Exception) override {performRedo(); return true;}
+        void performUndo() throw (Exception) override {mValue -= mSummand;}
+        void performRedo() throw (Exception) override {mValue += mSummand;}
+        bool performCanMergeWith(const UndoCommand& other) const noexcept override {
+            return static_cast<const AddValueCommand&>(other).mSummand != 0;
+        }
+        bool performMergeWith(const UndoCommand& other) noexcept override {
+            mSummand += static_cast<const AddValueCommand&>(other).mSummand;
+            return true;
+        }
+
+        int& mValue;
+        int mSummand;
+};
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class UndoStackTest : public ::testing::Test
+{
+    protected:
+
+        UndoStackTest() : mValue(0), mDeleted(0) {
+            mStack.setMaxDepth(0);
+            mStack.setMemoryBudget(0);
+            mStack.setMergeWindow(0);
+        }
+
+        void exec(int newValue, qint64 memoryUsage = 0) {
+            mStack.execCmd(new SetValueCommand(mValue, newValue, memoryUsage, &mDeleted));
+        }
+
+        /// Undo all commands and return how many could be undone
+        int undoAll() {
+            int count = 0;
+            while (mStack.canUndo()) {
+                mStack.undo();
+                ++count;
+            }
+            return count;
+        }
+
+        int mValue;
+        int mDeleted;       ///< count of deleted commands
+        UndoStack mStack;   ///< declared last to delete the commands first
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(UndoStackTest, testMaxDepthEvictsOldestCommands)
+{
+    mStack.setMaxDepth(5);
+    for (int i = 1; i <= 10; ++i) exec(i);
+    EXPECT_EQ(5, mDeleted);
+    EXPECT_EQ(10, mValue); // evicting does not modify the document
+
+    EXPECT_EQ(5, undoAll());
+    EXPECT_EQ(5, mValue);
+    while (mStack.canRedo()) mStack.redo();
+    EXPECT_EQ(10, mValue);
+
+    // reducing the depth evicts immediately
+    mStack.setMaxDepth(2);
+    EXPECT_EQ(8, mDeleted);
+    EXPECT_EQ(2, undoAll());
+    EXPECT_EQ(8, mValue);
+}
+
+TEST_F(UndoStackTest, testMemoryBudgetEvictsOldestCommands)
+{
+    mStack.setMemoryBudget(1000);
+    for (int i = 1; i <= 10; ++i) exec(i, 300);
+    EXPECT_EQ(7, mDeleted);
+    EXPECT_EQ(900, mStack.getMemoryUsage());
+
+    // the newest command is always kept, even if it exceeds the budget alone
+    exec(11, 5000);
+    EXPECT_EQ(10, mDeleted);
+    EXPECT_EQ(5000, mStack.getMemoryUsage());
+    EXPECT_EQ(1, undoAll());
+    EXPECT_EQ(10, mValue);
+}
+
+TEST_F(UndoStackTest, testEvictedCleanStateBecomesUnreachable)
+{
+    mStack.setMaxDepth(3);
+    exec(1);
+    mStack.setClean();
+    exec(2);
+    exec(3);
+    exec(4); // evicts "1", but the clean state (after "1") is still reachable
+    EXPECT_EQ(1, mDeleted);
+    EXPECT_FALSE(mStack.isClean());
+    EXPECT_EQ(3, undoAll());
+    EXPECT_EQ(1, mValue);
+    EXPECT_TRUE(mStack.isClean());
+    while (mStack.canRedo()) mStack.redo();
+
+    exec(5); // evicts "2", now the clean state does no longer exist
+    EXPECT_EQ(2, mDeleted);
+    EXPECT_FALSE(mStack.isClean());
+    while (mStack.canUndo()) {
+        mStack.undo();
+        EXPECT_FALSE(mStack.isClean());
+    }
+    EXPECT_EQ(2, mValue);
+}
+
+TEST_F(UndoStackTest, testCleanStateInRedoRegion)
+{
+    for (int i = 1; i <= 6; ++i) exec(i);
+    mStack.undo();
+    mStack.setClean(); // clean state with value 5
+    mStack.undo();
+    mStack.undo();
+    EXPECT_EQ(3, mValue);
+    EXPECT_FALSE(mStack.isClean());
+
+    // evicting commands below the current index keeps the clean state in the redo region
+    mStack.setMaxDepth(4);
+    EXPECT_EQ(2, mDeleted);
+    EXPECT_EQ(3, mValue);
+    mStack.redo();
+    mStack.redo();
+    EXPECT_EQ(5, mValue);
+    EXPECT_TRUE(mStack.isClean());
+
+    // pushing a new command deletes the redo region, incl. the clean state
+    mStack.undo();
+    mStack.undo();
+    exec(7);
+    EXPECT_FALSE(mStack.canRedo());
+    while (mStack.canUndo()) {
+        mStack.undo();
+        EXPECT_FALSE(mStack.isClean());
+    }
+}
+
+TEST_F(UndoStackTest, testActiveCommandGroupIsNeverEvicted)
+{
+    mStack.setMaxDepth(2);
+    exec(1);
+    exec(2);
+    exec(3);
+    EXPECT_EQ(1, mDeleted);
+
+    mStack.beginCmdGroup("Group");
+    mStack.appendToCmdGroup(new SetValueCommand(mValue, 4, 1000000, &mDeleted));
+    mStack.appendToCmdGroup(new SetValueCommand(mValue, 5, 1000000, &mDeleted));
+
+    // all older commands are evicted, but never the active group
+    mStack.setMaxDepth(1);
+    mStack.setMemoryBudget(1);
+    EXPECT_EQ(3, mDeleted);
+    EXPECT_TRUE(mStack.isCommandGroupActive());
+    mStack.appendToCmdGroup(new SetValueCommand(mValue, 6, 1000000, &mDeleted));
+    mStack.commitCmdGroup();
+    EXPECT_EQ(3, mDeleted);
+    EXPECT_EQ(6, mValue);
+
+    // the committed group is the newest command, so it is kept
+    EXPECT_EQ(1, undoAll());
+    EXPECT_EQ(3, mValue);
+    mStack.redo();
+    EXPECT_EQ(6, mValue);
+}
+
+TEST_F(UndoStackTest, testMergeWithinWindow)
+{
+    mStack.setMergeWindow(60000);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    mStack.execCmd(new AddValueCommand(mValue, 3));
+    EXPECT_EQ(6, mValue);
+
+    // all three commands are merged into one
+    EXPECT_EQ(1, undoAll());
+    EXPECT_EQ(0, mValue);
+    mStack.redo();
+    EXPECT_EQ(6, mValue);
+
+    // commands with another merge ID are not merged
+    exec(10);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    EXPECT_EQ(11, mValue);
+    EXPECT_EQ(3, undoAll());
+}
+
+TEST_F(UndoStackTest, testNoMergeOutsideWindow)
+{
+    mStack.setMergeWindow(1);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    QThread::msleep(20);
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    EXPECT_EQ(3, mValue);
+    mStack.undo();
+    EXPECT_EQ(1, mValue);
+    mStack.undo();
+    EXPECT_EQ(0, mValue);
+
+    // a merge window of zero disables merging
+    mStack.setMergeWindow(0);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    EXPECT_EQ(2, undoAll());
+}
+
+TEST_F(UndoStackTest, testNoMergeAcrossCleanState)
+{
+    mStack.setMergeWindow(60000);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    mStack.setClean();
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    EXPECT_FALSE(mStack.isClean());
+
+    // the clean state must still be reachable
+    mStack.undo();
+    EXPECT_EQ(1, mValue);
+    EXPECT_TRUE(mStack.isClean());
+    mStack.undo();
+    EXPECT_EQ(0, mValue);
+}
+
+TEST_F(UndoStackTest, testNoMergeWithCommandsToRedo)
+{
+    mStack.setMergeWindow(60000);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    exec(10);
+    mStack.undo();
+    EXPECT_EQ(3, mValue);
+    EXPECT_TRUE(mStack.canRedo());
+
+    // the new command replaces the redo region instead of being merged
+    mStack.execCmd(new AddValueCommand(mValue, 4));
+    EXPECT_EQ(7, mValue);
+    EXPECT_FALSE(mStack.canRedo());
+    mStack.undo();
+    EXPECT_EQ(3, mValue);
+    mStack.undo();
+    EXPECT_EQ(0, mValue);
+    EXPECT_FALSE(mStack.canUndo());
+}
+
+TEST_F(UndoStackTest, testNoMergeIfRefused)
+{
+    mStack.setMergeWindow(60000);
+    mStack.execCmd(new AddValueCommand(mValue, 1));
+    mStack.execCmd(new AddValueCommand(mValue, 0));
+    mStack.execCmd(new AddValueCommand(mValue, 2));
+    EXPECT_EQ(3, mValue);
+    EXPECT_EQ(2, undoAll());
+    EXPECT_EQ(0, mValue);
+}
+
+TEST_F(UndoStackTest, testCanMergeWithChangesNothing)
+{
+    AddValueCommand first(mValue, 1);
+    AddValueCommand second(mValue, 2);
+    AddValueCommand zero(mValue, 0);
+    EXPECT_FALSE(first.canMergeWith(second)); // not executed yet
+    first.execute();
+    second.execute();
+    zero.execute();
+    EXPECT_FALSE(first.canMergeWith(first));
+    EXPECT_FALSE(first.canMergeWith(zero));
+    EXPECT_TRUE(first.canMergeWith(second));
+    EXPECT_TRUE(first.canMergeWith(second)); // still possible, nothing was merged
+    EXPECT_EQ(3, mValue);
+    first.undo();
+    EXPECT_EQ(2, mValue);
+}
+
+TEST_F(UndoStackTest, testUndoAfterMergeRestoresOriginalState)
+{
+    mStack.setMergeWindow(60000);
+    exec(5);
+    for (int i = 0; i < 100; ++i) {
+        mStack.execCmd(new AddValueCommand(mValue, (i % 2) ? 3 : -1));
+    }
+    EXPECT_EQ(105, mValue);
+    mStack.undo();
+    EXPECT_EQ(5, mValue);
+    mStack.redo();
+    EXPECT_EQ(105, mValue);
+    mStack.undo();
+    mStack.undo();
+    EXPECT_EQ(0, mValue);
+    EXPECT_FALSE(mStack.canUndo());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class UuidTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(UuidTest, testDefaultConstructor)
+{
+    Uuid uuid;
+    EXPECT_TRUE(uuid.isNull());
+    EXPECT_TRUE(uuid.toStr().isNull());
+    EXPECT_FALSE(uuid == uuid);
+}
+
+TEST_F(UuidTest, testValidString)
+{
+    QString str = "d79d354b-62bd-4866-8d3e-ff0ea2c3b17b";
+    Uuid uuid(str);
+    EXPECT_FALSE(uuid.isNull());
+    EXPECT_EQ(str, uuid.toStr());
+    EXPECT_TRUE(uuid == Uuid(str.toUpper()));
+    EXPECT_TRUE(uuid == Uuid(str));
+    EXPECT_FALSE(uuid != Uuid(str));
+    EXPECT_EQ(qHash(uuid, 0), qHash(Uuid(str), 0));
+}
+
+TEST_F(UuidTest, testStringRoundTripKeepsCase)
+{
+    QStringList strings = {
+        "d79d354b-62bd-4866-8d3e-ff0ea2c3b17b",
+        "D79D354B-62BD-4866-8D3E-FF0EA2C3B17B",
+        "d79D354b-62Bd-4866-8d3E-fF0ea2C3b17B",
+    };
+    foreach (const QString& str, strings) {
+        Uuid uuid(str);
+        EXPECT_EQ(str, uuid.toStr());
+        EXPECT_EQ(str, Uuid(uuid).toStr());
+        EXPECT_EQ(str, Uuid(uuid.toStr()).toStr());
+        EXPECT_EQ(uuid, Uuid(strings.first()));
+        EXPECT_EQ(qHash(uuid, 0), qHash(Uuid(strings.first()), 0));
+    }
+}
+
+TEST_F(UuidTest, testInvalidStrings)
+{
+    EXPECT_TRUE(Uuid("").isNull());
+    EXPECT_TRUE(Uuid("{d79d354b-62bd-4866-8d3e-ff0ea2c3b17b}").isNull());  // braces
+    EXPECT_TRUE(Uuid("d79d354b-62bd-1866-8d3e-ff0ea2c3b17b").isNull());    // version 1
+    EXPECT_TRUE(Uuid("d79d354b-62bd-4866-cd3e-ff0ea2c3b17b").isNull());    // variant
+    EXPECT_TRUE(Uuid("00000000-0000-0000-0000-000000000000").isNull());
+}
+
+TEST_F(UuidTest, testCreateRandom)
+{
+    Uuid uuid1 = Uuid::createRandom();
+    Uuid uuid2 = Uuid::createRandom();
+    EXPECT_FALSE(uuid1.isNull());
+    EXPECT_EQ(uuid1, Uuid(uuid1.toStr()));
+    EXPECT_NE(uuid1, uuid2);
+}
+
+TEST_F(UuidTest, testOrderingMatchesStrings)
+{
+    QList<Uuid> uuids;
+    for (int i = 0; i < 100; ++i) {
+        uuids.append(Uuid::createRandom());
+    }
+    foreach (const Uuid& a, uuids) {
+        foreach (const Uuid& b, uuids) {
+            EXPECT_EQ(a.toStr() < b.toStr(), a < b);
+            EXPECT_EQ(a.toStr() > b.toStr(), a > b);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
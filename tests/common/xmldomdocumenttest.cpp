@@ -0,0 +1,253 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <QtXml>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <librepcbcommon/exceptions.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbcommon/fileio/xmldomdocument.h>
+#include <librepcbcommon/fileio/xmldomelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class XmlDomDocumentTest : public ::testing::Test
+{
+    protected:
+
+        static QByteArray createBoardLikeXml(int netlineCount)
+        {
+            QByteArray xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<board version=\"0\">\n <netlines>\n");
+            for (int i = 0; i < netlineCount; ++i) {
+                xml.append(QString(" <netline uuid=\"{%1}\" layer=\"16\" width=\"0.25\" "
+                                   "start_point=\"%2\" end_point=\"%3\"/>\n")
+                           .arg(QUuid::createUuid().toString().mid(1, 36)).arg(i).arg(i + 1)
+                           .toUtf8());
+            }
+            xml.append(" </netlines>\n</board>\n");
+            return xml;
+        }
+
+        /// The resident set size of this process in kB (only available on Linux)
+        static qint64 residentSetSizeKb()
+        {
+            QFile file("/proc/self/status");
+            if (!file.open(QIODevice::ReadOnly)) return -1;
+            foreach (const QByteArray& line, file.readAll().split('\n')) {
+                if (line.startsWith("VmRSS:")) {
+                    return line.mid(6).trimmed().split(' ').first().toLongLong();
+                }
+            }
+            return -1;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(XmlDomDocumentTest, testParseTextAndChildElements)
+{
+    QByteArray xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<root version=\"0\">\n"
+                   " <!-- a comment -->\n"
+                   " <text>Hello &amp; World</text>\n"
+                   " <node attr=\"value\">\n"
+                   "  <child/>\n"
+                   "  <child>foo</child>\n"
+                   " </node>\n"
+                   " <empty></empty>\n"
+                   "</root>\n");
+    XmlDomDocument doc(xml, FilePath());
+    XmlDomElement& root = doc.getRoot();
+
+    EXPECT_EQ(QString("root"), root.getName());
+    EXPECT_EQ(0, doc.getFileVersion());
+    EXPECT_EQ(3, root.getChildCount()); // whitespace and comments are ignored
+
+    XmlDomElement* text = root.getFirstChild("text", true);
+    EXPECT_FALSE(text->hasChilds());
+    EXPECT_EQ(QString("Hello & World"), text->getText<QString>(true));
+
+    XmlDomElement* node = root.getFirstChild("node", true);
+    EXPECT_EQ(QString("value"), node->getAttribute<QString>("attr", true));
+    EXPECT_EQ(2, node->getChildCount());
+    EXPECT_THROW(node->getText<QString>(false), Exception); // has childs, so no text
+    EXPECT_EQ(QString("foo"), node->getFirstChild("child", true)->getNextSibling()
+                              ->getText<QString>(true));
+
+    XmlDomElement* empty = root.getFirstChild("empty", true);
+    EXPECT_FALSE(empty->hasChilds());
+    EXPECT_EQ(QString(), empty->getText<QString>(false));
+    EXPECT_THROW(empty->getText<QString>(true), Exception);
+}
+
+TEST_F(XmlDomDocumentTest, testMalformedDocumentThrows)
+{
+    EXPECT_THROW(XmlDomDocument(QByteArray("<root><child></root>"), FilePath()), Exception);
+    EXPECT_THROW(XmlDomDocument(QByteArray("<root attr=\"1></root>"), FilePath()), Exception);
+    EXPECT_THROW(XmlDomDocument(QByteArray("<root/><second/>"), FilePath()), Exception);
+    EXPECT_THROW(XmlDomDocument(QByteArray("<root>"), FilePath()), Exception);
+    EXPECT_THROW(XmlDomDocument(QByteArray(""), FilePath()), Exception);
+}
+
+TEST_F(XmlDomDocumentTest, testParseAndSaveGivesIdenticalBytes)
+{
+    XmlDomElement* root = new XmlDomElement("root");
+    XmlDomDocument doc(*root);
+    doc.setFileVersion(0);
+    root->setAttribute("name", QString("<special> & \"chars\""));
+    root->setAttribute("a", 1);
+    XmlDomElement* node = root->appendChild("node");
+    node->setAttribute("z", true);
+    node->setAttribute("uuid", QString("{c1d3a5e2-6c4f-4d2b-9f0e-1a2b3c4d5e6f}"));
+    node->appendTextChild("text", QString("Text with <special> & \"chars\""));
+    node->appendTextChild("empty_text", QString(""));
+    node->appendChild("empty");
+    root->appendTextChild("unicode", QString::fromUtf8("\xc3\xa4\xc3\xb6\xc3\xbc \xce\xa9"));
+    QByteArray saved = doc.toByteArray();
+
+    XmlDomDocument parsed(saved, FilePath());
+    EXPECT_EQ(saved, parsed.toByteArray());
+    EXPECT_EQ(QString("Text with <special> & \"chars\""),
+              parsed.getRoot().getFirstChild("node/text", true, true)->getText<QString>(true));
+}
+
+TEST_F(XmlDomDocumentTest, testAttributesAreSavedInSortedOrder)
+{
+    XmlDomDocument doc(QByteArray("<root c=\"3\" a=\"1\" b=\"2\"><child y=\"1\" x=\"2\"/></root>"),
+                       FilePath());
+    QByteArray saved = doc.toByteArray();
+    EXPECT_TRUE(saved.contains("<root a=\"1\" b=\"2\" c=\"3\">")) << saved.constData();
+    EXPECT_TRUE(saved.contains("<child x=\"2\" y=\"1\"/>")) << saved.constData();
+
+    // the order must not depend on the order in which the attributes were set
+    XmlDomElement* root = new XmlDomElement("root");
+    XmlDomDocument doc2(*root);
+    root->setAttribute("b", 2);
+    root->setAttribute("c", 3);
+    root->setAttribute("a", 1);
+    root->appendChild("child");
+    root->getFirstChild(true)->setAttribute("y", 1);
+    root->getFirstChild(true)->setAttribute("x", 2);
+    EXPECT_EQ(saved, doc2.toByteArray());
+}
+
+/**
+ * Benchmark of the single-pass parser compared to Qt's QDomDocument, which was used
+ * before to build an intermediate DOM tree. Run it explicitly with
+ * "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(XmlDomDocumentTest, DISABLED_benchmarkParseLargeDocument)
+{
+    QByteArray xml = createBoardLikeXml(100000);
+    QElapsedTimer timer;
+
+    // XmlDomDocument is measured first, so freed memory of the other parser can not make
+    // its resident set size increase look smaller than it is
+    qint64 rssBefore = residentSetSizeKb();
+    timer.start();
+    QScopedPointer<XmlDomDocument> doc(new XmlDomDocument(xml, FilePath()));
+    qint64 xmlDomMs = timer.elapsed();
+    qint64 xmlDomKb = residentSetSizeKb() - rssBefore;
+    EXPECT_EQ(100000, doc->getRoot().getFirstChild("netlines", true)->getChildCount());
+    doc.reset();
+
+    rssBefore = residentSetSizeKb();
+    timer.start();
+    QScopedPointer<QDomDocument> qDomDoc(new QDomDocument());
+    EXPECT_TRUE(qDomDoc->setContent(xml, false));
+    qint64 qDomMs = timer.elapsed();
+    qint64 qDomKb = residentSetSizeKb() - rssBefore;
+    qDomDoc.reset();
+
+    std::cout << "XML size:       " << xml.size() / 1024 << " kB" << std::endl;
+    std::cout << "XmlDomDocument: " << xmlDomMs << " ms, RSS +" << xmlDomKb << " kB" << std::endl;
+    std::cout << "QDomDocument:   " << qDomMs << " ms, RSS +" << qDomKb << " kB "
+              << "(the old loader needed this in addition to the XmlDomDocument)" << std::endl;
+}
+
+/**
+ * Memory usage of a parsed board-like document, compared to an emulation of the previous
+ * element layout (a separately allocated tag name and a QHash of attributes with separately
+ * allocated names per element). Run it explicitly with
+ * "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(XmlDomDocumentTest, DISABLED_benchmarkMemoryUsage)
+{
+    struct OldElement {
+        QString name;
+        QString text;
+        QList<OldElement*> childs;
+        QHash<QString, QString> attributes;
+    };
+
+    const int count = 100000;
+    QByteArray xml = createBoardLikeXml(count);
+
+    // the current layout is measured first, see benchmarkParseLargeDocument
+    qint64 rssBefore = residentSetSizeKb();
+    QScopedPointer<XmlDomDocument> doc(new XmlDomDocument(xml, FilePath()));
+    qint64 currentKb = residentSetSizeKb() - rssBefore;
+    doc.reset();
+
+    rssBefore = residentSetSizeKb();
+    QList<OldElement*> oldElements;
+    QXmlStreamReader reader(xml);
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement) {
+            OldElement* element = new OldElement();
+            element->name = reader.qualifiedName().toString();
+            foreach (const QXmlStreamAttribute& attribute, reader.attributes()) {
+                element->attributes.insert(attribute.qualifiedName().toString(),
+                                           attribute.value().toString());
+            }
+            if (!oldElements.isEmpty()) oldElements.first()->childs.append(element);
+            oldElements.append(element);
+        }
+    }
+    qint64 oldKb = residentSetSizeKb() - rssBefore;
+    qDeleteAll(oldElements);
+
+    std::cout << "Elements:       " << count << std::endl;
+    std::cout << "Current layout: RSS +" << currentKb << " kB ("
+              << (currentKb * 1024 / count) << " bytes per element)" << std::endl;
+    std::cout << "Old layout:     RSS +" << oldKb << " kB ("
+              << (oldKb * 1024 / count) << " bytes per element)" << std::endl;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
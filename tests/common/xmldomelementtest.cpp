@@ -0,0 +1,192 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/exceptions.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbcommon/fileio/xmldomdocument.h>
+#include <librepcbcommon/fileio/xmldomelement.h>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class XmlDomElementTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(XmlDomElementTest, testSiblingNavigation)
+{
+    XmlDomElement root("root");
+    XmlDomElement* a1 = root.appendChild("a");
+    XmlDomElement* b1 = root.appendChild("b");
+    XmlDomElement* a2 = root.appendChild("a");
+    XmlDomElement* c1 = root.appendChild("c");
+
+    EXPECT_EQ(b1, a1->getNextSibling());
+    EXPECT_EQ(a2, a1->getNextSibling("a"));
+    EXPECT_EQ(c1, a1->getNextSibling("c"));
+    EXPECT_EQ(nullptr, a1->getNextSibling("d"));
+    EXPECT_EQ(nullptr, c1->getNextSibling());
+    EXPECT_THROW(c1->getNextSibling(QString(), true), Exception);
+
+    EXPECT_EQ(a2, c1->getPreviousSibling());
+    EXPECT_EQ(b1, c1->getPreviousSibling("b"));
+    EXPECT_EQ(a1, a2->getPreviousSibling("a"));
+    EXPECT_EQ(nullptr, a1->getPreviousSibling());
+    EXPECT_THROW(a1->getPreviousSibling(QString(), true), Exception);
+
+    EXPECT_EQ(nullptr, root.getNextSibling()); // no parent
+    EXPECT_EQ(nullptr, root.getPreviousSibling());
+}
+
+TEST_F(XmlDomElementTest, testSiblingNavigationAfterRemoveChild)
+{
+    XmlDomElement root("root");
+    XmlDomElement* a1 = root.appendChild("a");
+    XmlDomElement* b1 = root.appendChild("b");
+    XmlDomElement* a2 = root.appendChild("a");
+    XmlDomElement* c1 = root.appendChild("c");
+
+    // remove an element in the middle
+    root.removeChild(b1, true);
+    EXPECT_EQ(3, root.getChildCount());
+    EXPECT_EQ(a2, a1->getNextSibling());
+    EXPECT_EQ(a1, a2->getPreviousSibling());
+    EXPECT_EQ(c1, a2->getNextSibling());
+    EXPECT_EQ(nullptr, a1->getNextSibling("b"));
+
+    // remove the first element without deleting it
+    root.removeChild(a1, false);
+    EXPECT_EQ(nullptr, a1->getParent());
+    EXPECT_EQ(nullptr, a1->getNextSibling());
+    EXPECT_EQ(a2, root.getFirstChild(true));
+    EXPECT_EQ(nullptr, a2->getPreviousSibling());
+    EXPECT_EQ(c1, a2->getNextSibling());
+
+    // append it again at the end
+    root.appendChild(a1);
+    EXPECT_EQ(a1, c1->getNextSibling());
+    EXPECT_EQ(a1, c1->getNextSibling("a"));
+    EXPECT_EQ(c1, a1->getPreviousSibling());
+    EXPECT_EQ(a2, a1->getPreviousSibling("a"));
+    EXPECT_EQ(nullptr, a1->getNextSibling());
+
+    // deleting a child removes it from its parent
+    delete c1;
+    EXPECT_EQ(2, root.getChildCount());
+    EXPECT_EQ(a1, a2->getNextSibling());
+    EXPECT_EQ(a2, a1->getPreviousSibling());
+}
+
+TEST_F(XmlDomElementTest, testIterateManySiblings)
+{
+    XmlDomElement root("root");
+    for (int i = 0; i < 1000; ++i) {
+        root.appendChild((i % 2) ? "odd" : "even");
+    }
+
+    int count = 0;
+    for (XmlDomElement* node = root.getFirstChild("even", false); node;
+         node = node->getNextSibling("even")) {
+        ++count;
+    }
+    EXPECT_EQ(500, count);
+
+    count = 0;
+    for (XmlDomElement* node = root.getFirstChild("*", true, false); node;
+         node = node->getNextSibling()) {
+        ++count;
+    }
+    EXPECT_EQ(1000, count);
+}
+
+TEST_F(XmlDomElementTest, testSetOverwriteAndRemoveAttributes)
+{
+    XmlDomElement element("element");
+    EXPECT_FALSE(element.hasAttribute("a"));
+    EXPECT_THROW(element.getAttribute<QString>("a", false), Exception);
+
+    element.setAttribute("a", QString("foo"));
+    element.setAttribute("b", 42);
+    element.setAttribute("c", Length::fromMm(1.5));
+    element.setAttribute("d", QString(""));
+    EXPECT_TRUE(element.hasAttribute("a"));
+    EXPECT_EQ(QString("foo"), element.getAttribute<QString>("a", true));
+    EXPECT_EQ(42, element.getAttribute<int>("b", true));
+    EXPECT_EQ(Length::fromMm(1.5), element.getAttribute<Length>("c", true));
+    EXPECT_EQ(QString(""), element.getAttribute<QString>("d", false));
+    EXPECT_THROW(element.getAttribute<QString>("d", true), Exception);
+    EXPECT_THROW(element.getAttribute<int>("a", true), Exception); // not a number
+
+    // overwriting must not add a second attribute with the same name
+    element.setAttribute("a", QString("bar"));
+    EXPECT_EQ(QString("bar"), element.getAttribute<QString>("a", true));
+    element.removeAttribute("a");
+    EXPECT_FALSE(element.hasAttribute("a"));
+    EXPECT_THROW(element.getAttribute<QString>("a", false), Exception);
+
+    // the other attributes are not affected
+    EXPECT_EQ(42, element.getAttribute<int>("b", true));
+    element.removeAttribute("b");
+    element.removeAttribute("b"); // removing a non-existent attribute does nothing
+    EXPECT_FALSE(element.hasAttribute("b"));
+    EXPECT_TRUE(element.hasAttribute("c"));
+    EXPECT_TRUE(element.hasAttribute("d"));
+}
+
+TEST_F(XmlDomElementTest, testParsedNamesAreShared)
+{
+    XmlDomDocument doc(QByteArray("<root><point x=\"1\" y=\"2\"/><point x=\"3\" y=\"4\"/></root>"),
+                       FilePath());
+    XmlDomElement* p1 = doc.getRoot().getFirstChild("point", true);
+    XmlDomElement* p2 = p1->getNextSibling("point", true);
+    EXPECT_EQ(p1->getName().constData(), p2->getName().constData()); // interned
+    EXPECT_EQ(1, p1->getAttribute<int>("x", true));
+    EXPECT_EQ(4, p2->getAttribute<int>("y", true));
+
+    // modifying an element must not affect the other elements with the same names
+    p1->setName("pt");
+    p1->setAttribute("x", 5);
+    EXPECT_EQ(QString("point"), p2->getName());
+    EXPECT_EQ(3, p2->getAttribute<int>("x", true));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -22,6 +22,7 @@
  ****************************************************************************************/
 
 #include <QtCore>
+#include <QtWidgets>
 #include <gmock/gmock.h>
 #include <librepcbcommon/debug.h>
 
@@ -40,6 +41,15 @@ int main(int argc, char *argv[])
     Debug::instance()->setDebugLevelLogFile(Debug::DebugLevel_t::Nothing);
     Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Nothing);
 
+    // projects need a QApplication (e.g. for the graphics scenes of boards and schematics),
+    // use the offscreen platform if there is no display (e.g. on the CI server)
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MAC)
+    if (qgetenv("DISPLAY").isEmpty() && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#endif
+    QApplication app(argc, argv);
+
     // init gmock and run all tests
     ::testing::InitGoogleMock(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbproject/project.h>
+#include <librepcbproject/circuit/circuit.h>
+#include <librepcbproject/circuit/netclass.h>
+#include <librepcbproject/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CircuitTest : public ::testing::Test
+{
+    protected:
+
+        FilePath mTmpDir;
+        QScopedPointer<Project> mProject;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+            mProject.reset(Project::create(mTmpDir.getPathTo("project/project.lpp")));
+        }
+
+        virtual void TearDown() override
+        {
+            mProject.reset();
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        /// Add net signals to the circuit until it contains "count" of them
+        QList<Uuid> addNetSignals(int count)
+        {
+            Circuit& circuit = mProject->getCircuit();
+            NetClass* netclass = circuit.getNetClassByName("default");
+            for (int i = circuit.getNetSignals().count(); i < count; ++i) {
+                NetSignal* netsignal = new NetSignal(circuit, *netclass, QString("N%1").arg(i), false);
+                circuit.addNetSignal(*netsignal);
+            }
+            return circuit.getNetSignals().keys();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CircuitTest, testGetNetSignalByUuid)
+{
+    QList<Uuid> uuids = addNetSignals(100);
+    ASSERT_EQ(100, uuids.count());
+    foreach (const Uuid& uuid, uuids) {
+        NetSignal* netsignal = mProject->getCircuit().getNetSignalByUuid(uuid);
+        ASSERT_NE(nullptr, netsignal);
+        EXPECT_EQ(uuid, netsignal->getUuid());
+    }
+    EXPECT_EQ(nullptr, mProject->getCircuit().getNetSignalByUuid(Uuid::createRandom()));
+    EXPECT_EQ(nullptr, mProject->getCircuit().getNetSignalByUuid(Uuid()));
+}
+
+/**
+ * Time per Circuit::getNetSignalByUuid() call for circuits of increasing size. Run it
+ * explicitly with "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(CircuitTest, DISABLED_benchmarkGetNetSignalByUuid)
+{
+    const int rounds = 100;
+    std::cout << "Net signals | Lookups | Time | per lookup" << std::endl;
+    for (int count = 1000; count <= 64000; count *= 4) {
+        QList<Uuid> uuids = addNetSignals(count);
+        int found = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < rounds; ++i) {
+            foreach (const Uuid& uuid, uuids) {
+                if (mProject->getCircuit().getNetSignalByUuid(uuid)) ++found;
+            }
+        }
+        qint64 ns = timer.nsecsElapsed();
+        EXPECT_EQ(rounds * uuids.count(), found);
+        std::cout << uuids.count() << " | " << found << " | " << (ns / 1000000) << " ms | "
+                  << (ns / found) << " ns" << std::endl;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,157 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbproject/project.h>
+#include <librepcbproject/circuit/circuit.h>
+#include <librepcbproject/circuit/netclass.h>
+#include <librepcbproject/circuit/netsignal.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardlayerstack.h>
+#include <librepcbproject/boards/items/bi_netline.h>
+#include <librepcbproject/boards/items/bi_netpoint.h>
+#include <librepcbproject/schematics/schematic.h>
+#include <librepcbproject/schematics/items/si_netline.h>
+#include <librepcbproject/schematics/items/si_netpoint.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+/**
+ * The items at a scene position are looked up in the index of the graphics scene, which
+ * only knows the bounding rects of the items. These tests check that the whole grab area
+ * of an item is covered, not only its painted area.
+ */
+class ItemsAtScenePosTest : public ::testing::Test
+{
+    protected:
+
+        FilePath mTmpDir;
+        QScopedPointer<Project> mProject;
+        NetSignal* mNetSignal;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+            mProject.reset(Project::create(mTmpDir.getPathTo("project/project.lpp")));
+            Circuit& circuit = mProject->getCircuit();
+            mNetSignal = new NetSignal(circuit, *circuit.getNetClassByName("default"),
+                                       "N1", false);
+            circuit.addNetSignal(*mNetSignal);
+        }
+
+        virtual void TearDown() override
+        {
+            mProject.reset();
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        /// Add a horizontal trace from (0, 0) to (10mm, 0) to the board
+        BI_NetLine* addBoardTrace(Board& board, const Length& width)
+        {
+            BoardLayer* layer = board.getLayerStack().getBoardLayer(BoardLayer::TopCopper);
+            BI_NetPoint* p1 = new BI_NetPoint(board, *layer, *mNetSignal, Point::fromMm(0, 0));
+            BI_NetPoint* p2 = new BI_NetPoint(board, *layer, *mNetSignal, Point::fromMm(10, 0));
+            board.addNetPoint(*p1);
+            board.addNetPoint(*p2);
+            BI_NetLine* netline = new BI_NetLine(board, *p1, *p2, width);
+            board.addNetLine(*netline);
+            return netline;
+        }
+
+        /// Add a horizontal wire from (0, 0) to (10mm, 0) to the schematic
+        SI_NetLine* addSchematicWire(Schematic& schematic, const Length& width)
+        {
+            SI_NetPoint* p1 = new SI_NetPoint(schematic, *mNetSignal, Point::fromMm(0, 0));
+            SI_NetPoint* p2 = new SI_NetPoint(schematic, *mNetSignal, Point::fromMm(10, 0));
+            schematic.addNetPoint(*p1);
+            schematic.addNetPoint(*p2);
+            SI_NetLine* netline = new SI_NetLine(schematic, *p1, *p2, width);
+            schematic.addNetLine(*netline);
+            return netline;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ItemsAtScenePosTest, testThinBoardTraceIsFoundInWholeGrabArea)
+{
+    // the grab area of traces is at least 0.1mm wide, i.e. wider than this trace
+    Board& board = *mProject->getBoards().first();
+    BI_NetLine* netline = addBoardTrace(board, Length(20000));
+
+    QList<BI_NetLine*> onLine = board.getNetLinesAtScenePos(Point::fromMm(5, 0), nullptr, nullptr);
+    ASSERT_EQ(1, onLine.count());
+    EXPECT_EQ(netline, onLine.first());
+
+    // inside the grab area, but outside of the painted trace
+    QList<BI_NetLine*> offLine = board.getNetLinesAtScenePos(Point::fromMm(5, 0.04), nullptr, nullptr);
+    ASSERT_EQ(1, offLine.count());
+    EXPECT_EQ(netline, offLine.first());
+    EXPECT_TRUE(board.getItemsAtScenePos(Point::fromMm(5, -0.04)).contains(netline));
+
+    // outside of the grab area
+    EXPECT_TRUE(board.getNetLinesAtScenePos(Point::fromMm(5, 0.2), nullptr, nullptr).isEmpty());
+}
+
+TEST_F(ItemsAtScenePosTest, testSchematicWireIsFoundInWholeGrabArea)
+{
+    // the grab area of wires is at least 1.27mm wide, much wider than the painted wire
+    Schematic& schematic = *mProject->getSchematics().first();
+    SI_NetLine* netline = addSchematicWire(schematic, Length(158750));
+
+    QList<SI_NetLine*> onLine = schematic.getNetLinesAtScenePos(Point::fromMm(5, 0));
+    ASSERT_EQ(1, onLine.count());
+    EXPECT_EQ(netline, onLine.first());
+
+    // inside the grab area, but outside of the painted wire
+    QList<SI_NetLine*> offLine = schematic.getNetLinesAtScenePos(Point::fromMm(5, 0.5));
+    ASSERT_EQ(1, offLine.count());
+    EXPECT_EQ(netline, offLine.first());
+    EXPECT_TRUE(schematic.getItemsAtScenePos(Point::fromMm(5, -0.5)).contains(netline));
+
+    // outside of the grab area
+    EXPECT_TRUE(schematic.getNetLinesAtScenePos(Point::fromMm(5, 1)).isEmpty());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
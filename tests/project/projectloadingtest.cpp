@@ -0,0 +1,215 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbproject/project.h>
+#include <librepcbproject/circuit/circuit.h>
+#include <librepcbproject/circuit/netclass.h>
+#include <librepcbproject/circuit/netsignal.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardlayerstack.h>
+#include <librepcbproject/boards/items/bi_netline.h>
+#include <librepcbproject/boards/items/bi_netpoint.h>
+#include <librepcbproject/boards/items/bi_via.h>
+#include <librepcbproject/schematics/schematic.h>
+#include <librepcbproject/schematics/items/si_netline.h>
+#include <librepcbproject/schematics/items/si_netpoint.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ProjectLoadingTest : public ::testing::Test
+{
+    protected:
+
+        struct CreatedItems {
+            QList<Uuid> netsignals;
+            QList<Uuid> vias;
+            QList<Uuid> boardNetPoints;
+            QList<Uuid> boardNetLines;
+            QList<Uuid> schematicNetPoints;
+            QList<Uuid> schematicNetLines;
+        };
+
+        FilePath mTmpDir;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+        }
+
+        virtual void TearDown() override
+        {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        /**
+         * Create and save a project with "count" net signals, each with a via and a trace
+         * on the board and a wire in the schematic
+         */
+        FilePath createProject(int count, CreatedItems* items = nullptr)
+        {
+            QString name = QString("project_%1").arg(count);
+            FilePath filepath = mTmpDir.getPathTo(name % "/" % name % ".lpp");
+            QScopedPointer<Project> project(Project::create(filepath));
+            Circuit& circuit = project->getCircuit();
+            NetClass* netclass = circuit.getNetClassByName("default");
+            Board* board = project->getBoards().first();
+            Schematic* schematic = project->getSchematics().first();
+            BoardLayer* layer = board->getLayerStack().getBoardLayer(BoardLayer::TopCopper);
+            for (int i = 0; i < count; ++i) {
+                NetSignal* netsignal = new NetSignal(circuit, *netclass, QString("N%1").arg(i), false);
+                circuit.addNetSignal(*netsignal);
+                Point pos = Point::fromMm(2 * (i % 100), 2 * (i / 100));
+
+                BI_Via* via = new BI_Via(*board, pos, BI_Via::Shape::Round, Length(600000),
+                                         Length(300000), netsignal);
+                board->addVia(*via);
+                BI_NetPoint* bp1 = new BI_NetPoint(*board, *layer, *netsignal, *via);
+                BI_NetPoint* bp2 = new BI_NetPoint(*board, *layer, *netsignal,
+                                                   pos + Point::fromMm(1, 0));
+                board->addNetPoint(*bp1);
+                board->addNetPoint(*bp2);
+                BI_NetLine* bl = new BI_NetLine(*board, *bp1, *bp2, Length(200000));
+                board->addNetLine(*bl);
+
+                SI_NetPoint* sp1 = new SI_NetPoint(*schematic, *netsignal, pos);
+                SI_NetPoint* sp2 = new SI_NetPoint(*schematic, *netsignal,
+                                                   pos + Point::fromMm(1, 0));
+                schematic->addNetPoint(*sp1);
+                schematic->addNetPoint(*sp2);
+                SI_NetLine* sl = new SI_NetLine(*schematic, *sp1, *sp2, Length(158750));
+                schematic->addNetLine(*sl);
+
+                if (items) {
+                    items->netsignals.append(netsignal->getUuid());
+                    items->vias.append(via->getUuid());
+                    items->boardNetPoints << bp1->getUuid() << bp2->getUuid();
+                    items->boardNetLines.append(bl->getUuid());
+                    items->schematicNetPoints << sp1->getUuid() << sp2->getUuid();
+                    items->schematicNetLines.append(sl->getUuid());
+                }
+            }
+            project->save(true);
+            return filepath;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ProjectLoadingTest, testSavedItemsAreFoundByUuid)
+{
+    CreatedItems items;
+    FilePath filepath = createProject(50, &items);
+    QScopedPointer<Project> project(new Project(filepath, false, true));
+    Board* board = project->getBoards().first();
+    Schematic* schematic = project->getSchematics().first();
+
+    EXPECT_EQ(50, project->getCircuit().getNetSignals().count());
+    foreach (const Uuid& uuid, items.netsignals) {
+        EXPECT_NE(nullptr, project->getCircuit().getNetSignalByUuid(uuid));
+    }
+    EXPECT_EQ(50, board->getVias().count());
+    foreach (const Uuid& uuid, items.vias) {
+        EXPECT_NE(nullptr, board->getViaByUuid(uuid));
+    }
+    foreach (const Uuid& uuid, items.boardNetPoints) {
+        EXPECT_NE(nullptr, board->getNetPointByUuid(uuid));
+    }
+    EXPECT_EQ(50, board->getNetLines().count());
+    foreach (const Uuid& uuid, items.boardNetLines) {
+        EXPECT_NE(nullptr, board->getNetLineByUuid(uuid));
+    }
+    foreach (const Uuid& uuid, items.schematicNetPoints) {
+        EXPECT_NE(nullptr, schematic->getNetPointByUuid(uuid));
+    }
+    foreach (const Uuid& uuid, items.schematicNetLines) {
+        EXPECT_NE(nullptr, schematic->getNetLineByUuid(uuid));
+    }
+    EXPECT_EQ(nullptr, board->getNetLineByUuid(items.vias.first())); // wrong item type
+}
+
+/**
+ * Time to open projects of increasing size, the time per net signal should stay about
+ * constant (linear scaling). Run it explicitly with
+ * "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(ProjectLoadingTest, DISABLED_benchmarkLoadBoardsAndSchematics)
+{
+    std::cout << "Net signals | Board items | Schematic items | Load time | per net signal"
+              << std::endl;
+    for (int count = 1000; count <= 16000; count *= 2) {
+        FilePath filepath = createProject(count);
+        QElapsedTimer timer;
+        timer.start();
+        QScopedPointer<Project> project(new Project(filepath, false, true));
+        qint64 ms = timer.elapsed();
+        std::cout << count << " | " << project->getBoards().first()->getAllItems().count()
+                  << " | " << project->getSchematics().first()->getAllItems().count()
+                  << " | " << ms << " ms | " << (1000 * ms / count) << " us" << std::endl;
+    }
+}
+
+/**
+ * Time to load only the board of projects of increasing size (without the schematics
+ * and the rest of the project). Run it explicitly with
+ * "--gtest_also_run_disabled_tests --gtest_filter=*benchmark*".
+ */
+TEST_F(ProjectLoadingTest, DISABLED_benchmarkLoadBoard)
+{
+    std::cout << "Net signals | Board items | Load time | per net signal" << std::endl;
+    for (int count = 1000; count <= 16000; count *= 2) {
+        FilePath filepath = createProject(count);
+        QScopedPointer<Project> project(new Project(filepath, false, true));
+        FilePath boardFilePath = project->getBoards().first()->getFilePath();
+        QElapsedTimer timer;
+        timer.start();
+        QScopedPointer<Board> board(new Board(*project, boardFilePath, false, true));
+        qint64 ms = timer.elapsed();
+        std::cout << count << " | " << board->getAllItems().count() << " | " << ms
+                  << " ms | " << (1000 * ms / count) << " us" << std::endl;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
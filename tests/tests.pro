@@ -13,8 +13,7 @@ GENERATED_DIR = ../generated
 # Use common project definitions
 include(../common.pri)
 
-QT += core
-QT -= gui widgets
+QT += core gui widgets xml sql printsupport concurrent opengl network
 
 CONFIG += console
 CONFIG -= app_bundle
@@ -22,6 +21,7 @@ CONFIG -= app_bundle
 LIBS += \
     -L$${DESTDIR} \
     -lgmock \
+    -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
     -llibrepcbcommon       # Another order could end up in "undefined reference" errors!
 
@@ -31,17 +31,30 @@ INCLUDEPATH += \
     ../libs
 
 DEPENDPATH += \
+    ../libs/librepcbproject \
     ../libs/librepcblibrary \
     ../libs/librepcbcommon
 
 PRE_TARGETDEPS += \
     $${DESTDIR}/libgmock.a \
+    $${DESTDIR}/liblibrepcbproject.a \
     $${DESTDIR}/liblibrepcblibrary.a \
     $${DESTDIR}/liblibrepcbcommon.a
 
 SOURCES += main.cpp \
+    common/airwiresbuildertest.cpp \
+    common/clearancecheckertest.cpp \
+    common/excellongeneratortest.cpp \
     common/filepathtest.cpp \
+    common/gerbergeneratortest.cpp \
     common/pointtest.cpp \
-    common/scopeguardtest.cpp
+    common/scopeguardtest.cpp \
+    common/undostacktest.cpp \
+    common/uuidtest.cpp \
+    common/xmldomdocumenttest.cpp \
+    common/xmldomelementtest.cpp \
+    project/circuittest.cpp \
+    project/itemsatscenepostest.cpp \
+    project/projectloadingtest.cpp
 
 HEADERS +=